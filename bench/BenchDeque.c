@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "Linked_list.h"
+#include "Deque.h"
+#include "Harness.h"
+
+#define NUM_ELEMENTS        1000000
+#define NUM_LOOKUPS         1000
+
+static void
+bench_list(void)
+{
+    list_t l;
+    uint32_t data;
+    uint32_t i;
+    double start;
+
+    list_init(&l, sizeof(uint32_t));
+
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          list_push(&l, (void *) &i);
+      }
+    bench_report("push", "list", NUM_ELEMENTS, bench_now() - start);
+
+    srand(1);
+    start = bench_now();
+    for (i = 0; i < NUM_LOOKUPS; i++)
+      {
+          list_get_by_index(&l, rand() % NUM_ELEMENTS, (void *) &data);
+      }
+    bench_report("get_by_index", "list", NUM_LOOKUPS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          list_pop_front(&l, (void *) &data);
+      }
+    bench_report("pop_front", "list", NUM_ELEMENTS, bench_now() - start);
+
+    list_destroy(&l);
+}
+
+static void
+bench_deque(void)
+{
+    deque_t d;
+    uint32_t data;
+    uint32_t i;
+    double start;
+
+    deque_init(&d, sizeof(uint32_t));
+
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          deque_push(&d, (void *) &i);
+      }
+    bench_report("push", "deque", NUM_ELEMENTS, bench_now() - start);
+
+    srand(1);
+    start = bench_now();
+    for (i = 0; i < NUM_LOOKUPS; i++)
+      {
+          deque_get_by_index(&d, rand() % NUM_ELEMENTS, (void *) &data);
+      }
+    bench_report("get_by_index", "deque", NUM_LOOKUPS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          deque_pop_front(&d, (void *) &data);
+      }
+    bench_report("pop_front", "deque", NUM_ELEMENTS, bench_now() - start);
+
+    deque_destroy(&d);
+}
+
+int
+main(void)
+{
+    printf("benchmark,structure,ops,seconds,ops_per_sec\n");
+
+    bench_list();
+    bench_deque();
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Linked_list.h"
+#include "Intrusive_list.h"
+#include "Harness.h"
+
+#define NUM_ELEMENTS        1000000
+#define PAYLOAD_SIZE        64
+
+typedef struct
+{
+    unsigned char payload[PAYLOAD_SIZE];
+    ilist_link_t link;
+} object_t;
+
+static void
+bench_list(object_t* pool)
+{
+    list_t l;
+    uint32_t i;
+    double start;
+
+    list_init(&l, sizeof(object_t));
+
+    // The list copies every object into a node of its own
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          list_push(&l, (void *) &pool[i]);
+      }
+    bench_report("push", "list", NUM_ELEMENTS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          list_pop_front(&l, (void *) &pool[i]);
+      }
+    bench_report("pop_front", "list", NUM_ELEMENTS, bench_now() - start);
+
+    list_destroy(&l);
+}
+
+static void
+bench_ilist(object_t* pool)
+{
+    ilist_t l;
+    uint32_t i;
+    double start;
+
+    ilist_init(&l);
+
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          ilist_push(&l, &pool[i].link);
+      }
+    bench_report("push", "ilist", NUM_ELEMENTS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          ilist_pop_front(&l);
+      }
+    bench_report("pop_front", "ilist", NUM_ELEMENTS, bench_now() - start);
+
+    ilist_destroy(&l);
+}
+
+int
+main(void)
+{
+    object_t* pool = calloc(NUM_ELEMENTS, sizeof(object_t));
+
+    printf("benchmark,structure,ops,seconds,ops_per_sec\n");
+
+    bench_list(pool);
+    bench_ilist(pool);
+
+    free(pool);
+
+    return 0;
+}
@@ -0,0 +1,219 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "Linked_list.h"
+#include "Harness.h"
+
+#define NUM_SAMPLES         200000
+#define NUM_ELEMENTS        1000
+#define MAX_PRODUCERS       4
+
+typedef struct bench_mode_t
+{
+    const char* name;
+    uint32_t flags;
+} bench_mode_t;
+
+static const bench_mode_t modes[] = {
+    {"mutex", 0},
+    {"mpsc", LIST_MPSC},
+    {"two_lock", LIST_TWO_LOCK},
+};
+
+static const uint32_t producerCounts[] = {1, MAX_PRODUCERS};
+
+static list_t l;
+static uint32_t itemsPerProducer;
+static bench_latency_t pushLatency[MAX_PRODUCERS];
+static bench_latency_t popLatency;
+
+static void*
+producer(void* arg)
+{
+    bench_latency_t* latency = (bench_latency_t *) arg;
+    uint64_t start;
+    uint32_t i;
+
+    for (i = 0; i < itemsPerProducer; i++)
+      {
+          start = bench_now_ns();
+          list_push(&l, (void *) &i);
+          bench_latency_add(latency, bench_now_ns() - start);
+      }
+
+    return NULL;
+}
+
+static void*
+consumer(void* arg)
+{
+    uint32_t total = *(uint32_t *) arg;
+    uint32_t received = 0;
+    uint32_t data;
+    uint64_t start;
+    uint64_t end;
+
+    // Only the pops that return an element are recorded, an empty list
+    // measures the polling loop rather than the list
+    while (received < total)
+      {
+          start = bench_now_ns();
+          if (list_pop_front(&l, (void *) &data) == 0)
+            {
+                end = bench_now_ns();
+                bench_latency_add(&popLatency, end - start);
+                received++;
+            }
+      }
+
+    return NULL;
+}
+
+static void
+bench_single(void)
+{
+    bench_latency_t latency;
+    uint32_t data;
+    uint64_t start;
+    uint32_t i;
+
+    list_init(&l, sizeof(uint32_t));
+    bench_latency_init(&latency, NUM_SAMPLES);
+
+    for (i = 0; i < NUM_SAMPLES; i++)
+      {
+          start = bench_now_ns();
+          list_push(&l, (void *) &i);
+          bench_latency_add(&latency, bench_now_ns() - start);
+      }
+    bench_latency_report(&latency, "push", "mutex", 1);
+
+    latency.numSamples = 0;
+    for (i = 0; i < NUM_SAMPLES; i++)
+      {
+          start = bench_now_ns();
+          list_pop_front(&l, (void *) &data);
+          bench_latency_add(&latency, bench_now_ns() - start);
+      }
+    bench_latency_report(&latency, "pop_front", "mutex", 1);
+
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          list_push(&l, (void *) &i);
+      }
+
+    srand(1);
+    latency.numSamples = 0;
+    for (i = 0; i < NUM_SAMPLES; i++)
+      {
+          start = bench_now_ns();
+          list_get_by_index(&l, rand() % NUM_ELEMENTS, (void *) &data);
+          bench_latency_add(&latency, bench_now_ns() - start);
+      }
+    bench_latency_report(&latency, "get_by_index", "mutex", 1);
+
+    bench_latency_free(&latency);
+    list_destroy(&l);
+}
+
+static void
+report_dwell(const bench_mode_t* mode, uint32_t threads)
+{
+    list_dwell_stats_t stats;
+
+    list_get_dwell(&l, &stats);
+    printf("dwell,%s,%u,%llu,%llu,%llu,%llu,%llu\n", mode->name, threads,
+           (unsigned long long) stats.count,
+           (unsigned long long) stats.p50Ns,
+           (unsigned long long) stats.p99Ns,
+           (unsigned long long) stats.p999Ns,
+           (unsigned long long) stats.maxNs);
+}
+
+static void
+bench_contended(const bench_mode_t* mode, uint32_t numProducers, 
+                uint8_t dwell)
+{
+    pthread_t producers[MAX_PRODUCERS];
+    pthread_t reader;
+    list_config_t config = {0};
+    bench_latency_t latency;
+    uint32_t total;
+    uint32_t i;
+    size_t j;
+
+    config.flags = mode->flags | (dwell ? LIST_DWELL_TIME : 0);
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    itemsPerProducer = NUM_SAMPLES / numProducers;
+    total = itemsPerProducer * numProducers;
+
+    bench_latency_init(&popLatency, total);
+    for (i = 0; i < numProducers; i++)
+      {
+          bench_latency_init(&pushLatency[i], itemsPerProducer);
+      }
+
+    pthread_create(&reader, NULL, consumer, (void *) &total);
+    for (i = 0; i < numProducers; i++)
+      {
+          pthread_create(&producers[i], NULL, producer,
+                         (void *) &pushLatency[i]);
+      }
+
+    for (i = 0; i < numProducers; i++)
+      {
+          pthread_join(producers[i], NULL);
+      }
+    pthread_join(reader, NULL);
+
+    // Merge the samples of every producer
+    bench_latency_init(&latency, total);
+    for (i = 0; i < numProducers; i++)
+      {
+          for (j = 0; j < pushLatency[i].numSamples; j++)
+            {
+                bench_latency_add(&latency, pushLatency[i].samples[j]);
+            }
+          bench_latency_free(&pushLatency[i]);
+      }
+
+    // The time spent in the queue is reported instead of the latencies, 
+    // which include the cost of stamping the nodes
+    if (dwell)
+      {
+          report_dwell(mode, numProducers + 1);
+      }
+    else
+      {
+          bench_latency_report(&latency, "push_contended", mode->name,
+                               numProducers + 1);
+          bench_latency_report(&popLatency, "pop_front_contended", mode->name,
+                               numProducers + 1);
+      }
+
+    bench_latency_free(&latency);
+    bench_latency_free(&popLatency);
+    list_destroy(&l);
+}
+
+int
+main(void)
+{
+    size_t i;
+    size_t j;
+
+    printf("benchmark,mode,threads,samples,p50_ns,p99_ns,p999_ns,max_ns\n");
+
+    bench_single();
+
+    for (i = 0; i < sizeof(modes) / sizeof(modes[0]); i++)
+      {
+          for (j = 0; j < sizeof(producerCounts) / sizeof(producerCounts[0]); j++)
+            {
+                bench_contended(&modes[i], producerCounts[j], 0);
+                bench_contended(&modes[i], producerCounts[j], 1);
+            }
+      }
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "Linked_list.h"
+#include "Harness.h"
+
+#define MAX_PAYLOAD         256
+#define NUM_LOOKUPS         1000
+#define MAX_LOOKUP_HOPS     100000000
+
+static const uint32_t elementCounts[] = {1000, 100000, 1000000};
+static const uint32_t payloadSizes[] = {8, 64, 256};
+
+static unsigned char data[MAX_PAYLOAD];
+
+static void
+touch(const void* element, void* arg)
+{
+    *(uint64_t *) arg += *(const unsigned char *) element;
+}
+
+static void
+report(const char* benchmark, uint32_t payload, uint32_t elements,
+       uint32_t ops, double elapsed)
+{
+    printf("%s,%u,%u,%u,%.6f,%.0f\n", benchmark, payload, elements, ops,
+           elapsed, ops / elapsed);
+}
+
+static void
+bench_singly(uint32_t elements, uint32_t payload)
+{
+    list_t l;
+    uint64_t total = 0;
+    uint32_t lookups;
+    uint32_t i;
+    double start;
+
+    list_init(&l, payload);
+
+    start = bench_now();
+    for (i = 0; i < elements; i++)
+      {
+          list_push(&l, (void *) data);
+      }
+    report("push", payload, elements, elements, bench_now() - start);
+
+    // A lookup walks half of the list on average, so the number of lookups
+    // is reduced for long lists to keep the run short
+    lookups = MAX_LOOKUP_HOPS / elements;
+    if (lookups > NUM_LOOKUPS)
+      {
+          lookups = NUM_LOOKUPS;
+      }
+
+    srand(1);
+    start = bench_now();
+    for (i = 0; i < lookups; i++)
+      {
+          list_get_by_index(&l, rand() % elements, (void *) data);
+      }
+    report("get_by_index", payload, elements, lookups, bench_now() - start);
+
+    start = bench_now();
+    list_for_each(&l, touch, (void *) &total);
+    report("for_each", payload, elements, elements, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < elements; i++)
+      {
+          list_pop_front(&l, (void *) data);
+      }
+    report("pop_front", payload, elements, elements, bench_now() - start);
+
+    list_destroy(&l);
+}
+
+static void
+bench_doubly(uint32_t elements, uint32_t payload)
+{
+    list_t l;
+    list_config_t config = {0};
+    uint32_t i;
+    double start;
+
+    // list_pop walks the whole list unless it is doubly linked
+    config.flags = LIST_DOUBLY_LINKED;
+    list_init_config(&l, payload, &config);
+
+    for (i = 0; i < elements; i++)
+      {
+          list_push(&l, (void *) data);
+      }
+
+    start = bench_now();
+    for (i = 0; i < elements; i++)
+      {
+          list_pop(&l, (void *) data);
+      }
+    report("pop_doubly", payload, elements, elements, bench_now() - start);
+
+    list_destroy(&l);
+}
+
+int
+main(void)
+{
+    size_t i;
+    size_t j;
+
+    printf("benchmark,payload,elements,ops,seconds,ops_per_sec\n");
+
+    for (i = 0; i < sizeof(elementCounts) / sizeof(elementCounts[0]); i++)
+      {
+          for (j = 0; j < sizeof(payloadSizes) / sizeof(payloadSizes[0]); j++)
+            {
+                bench_singly(elementCounts[i], payloadSizes[j]);
+                bench_doubly(elementCounts[i], payloadSizes[j]);
+            }
+      }
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include "Linked_list.h"
+#include "Harness.h"
+
+#define NUM_ELEMENTS        1000000
+#define WORK_ROUNDS         64
+
+static const uint32_t threadCounts[] = {1, 2, 4, 8};
+
+// Stands for an expensive callback so the walk is not the bottleneck
+static uint64_t
+work(uint32_t value)
+{
+    uint64_t hash = value;
+    uint32_t i;
+
+    for (i = 0; i < WORK_ROUNDS; i++)
+      {
+          hash = hash * 6364136223846793005ULL + 1442695040888963407ULL;
+      }
+    return hash;
+}
+
+static void
+hash_each(const void* data, void* arg)
+{
+    atomic_fetch_xor_explicit((atomic_ullong *) arg,
+                              work(*(const uint32_t *) data),
+                              memory_order_relaxed);
+}
+
+static void
+hash_serial(const void* data, void* arg)
+{
+    *(uint64_t *) arg ^= work(*(const uint32_t *) data);
+}
+
+static void
+hash_map(const void* data, void* acc)
+{
+    *(uint64_t *) acc ^= work(*(const uint32_t *) data);
+}
+
+static void
+hash_combine(void* acc, const void* other)
+{
+    *(uint64_t *) acc ^= *(const uint64_t *) other;
+}
+
+static void
+report(const char* benchmark, uint32_t threads, double elapsed)
+{
+    printf("%s,%u,%u,%.6f,%.0f\n", benchmark, threads, NUM_ELEMENTS,
+           elapsed, NUM_ELEMENTS / elapsed);
+}
+
+int
+main(void)
+{
+    list_t l;
+    atomic_ullong shared = 0;
+    uint64_t total = 0;
+    const uint64_t identity = 0;
+    uint32_t i;
+    size_t t;
+    double start;
+
+    list_init(&l, sizeof(uint32_t));
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          list_push(&l, (void *) &i);
+      }
+
+    printf("benchmark,threads,elements,seconds,elements_per_sec\n");
+
+    start = bench_now();
+    list_for_each(&l, hash_serial, (void *) &total);
+    report("for_each", 1, bench_now() - start);
+
+    for (t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); t++)
+      {
+          start = bench_now();
+          list_parallel_for_each(&l, hash_each, (void *) &shared,
+                                 threadCounts[t]);
+          report("parallel_for_each", threadCounts[t], bench_now() - start);
+
+          start = bench_now();
+          list_parallel_reduce(&l, hash_map, hash_combine,
+                               (const void *) &identity, (void *) &total,
+                               sizeof(uint64_t), threadCounts[t]);
+          report("parallel_reduce", threadCounts[t], bench_now() - start);
+      }
+
+    list_destroy(&l);
+    return 0;
+}
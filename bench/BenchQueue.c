@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "Linked_list.h"
+#include "Harness.h"
+
+#define NUM_ITEMS           1000000
+#define MAX_PRODUCERS       8
+#define MAX_CONSUMERS       4
+#define BATCH_SIZE          64
+
+typedef struct bench_mode_t
+{
+    const char* name;
+    uint32_t flags;
+} bench_mode_t;
+
+static const bench_mode_t modes[] = {
+    {"mutex", 0},
+    {"mpsc", LIST_MPSC},
+    {"two_lock", LIST_TWO_LOCK},
+};
+
+static const uint32_t producerCounts[] = {1, 2, 4, 8};
+static const uint32_t consumerCounts[] = {1, 2, MAX_CONSUMERS};
+
+static list_t l;
+static uint32_t itemsPerProducer;
+static uint32_t batchSize;
+static atomic_uint received;
+
+static void*
+producer(void* arg)
+{
+    uint32_t data[BATCH_SIZE] = {0};
+    uint32_t i;
+    uint32_t n;
+
+    for (i = 0; i < itemsPerProducer; i += n)
+      {
+          n = itemsPerProducer - i;
+          if (n > batchSize)
+            {
+                n = batchSize;
+            }
+
+          if (n == 1)
+            {
+                list_push(&l, (void *) &i);
+            }
+          else
+            {
+                list_push_n(&l, (void *) data, n);
+            }
+      }
+
+    return NULL;
+}
+
+static void*
+consumer(void* arg)
+{
+    uint32_t total = *(uint32_t *) arg;
+    uint32_t data[BATCH_SIZE];
+    uint32_t n;
+
+    // The consumers share the count of received items, so each one stops
+    // when all of them together got every item
+    while (atomic_load_explicit(&received, memory_order_relaxed) < total)
+      {
+          if (batchSize == 1)
+            {
+                n = (list_pop_front(&l, (void *) data) == 0);
+            }
+          else
+            {
+                n = list_pop_front_n(&l, (void *) data, batchSize);
+            }
+
+          if (n > 0)
+            {
+                atomic_fetch_add_explicit(&received, n, memory_order_relaxed);
+            }
+      }
+
+    return NULL;
+}
+
+static void
+bench_queue(const bench_mode_t* mode, uint32_t numProducers,
+            uint32_t numConsumers, uint32_t batch)
+{
+    pthread_t producers[MAX_PRODUCERS];
+    pthread_t consumers[MAX_CONSUMERS];
+    list_config_t config = {0};
+    uint32_t total;
+    uint32_t i;
+    double start;
+    double elapsed;
+
+    config.flags = mode->flags;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    batchSize = batch;
+    itemsPerProducer = NUM_ITEMS / numProducers;
+    total = itemsPerProducer * numProducers;
+    atomic_store(&received, 0);
+
+    start = bench_now();
+
+    for (i = 0; i < numConsumers; i++)
+      {
+          pthread_create(&consumers[i], NULL, consumer, (void *) &total);
+      }
+    for (i = 0; i < numProducers; i++)
+      {
+          pthread_create(&producers[i], NULL, producer, NULL);
+      }
+
+    for (i = 0; i < numProducers; i++)
+      {
+          pthread_join(producers[i], NULL);
+      }
+    for (i = 0; i < numConsumers; i++)
+      {
+          pthread_join(consumers[i], NULL);
+      }
+
+    elapsed = bench_now() - start;
+
+    printf("%s,%s,%u,%u,%u,%.6f,%.0f\n",
+           (batch == 1) ? "queue" : "queue_batch", mode->name, numProducers,
+           numConsumers, total, elapsed, total / elapsed);
+
+    list_destroy(&l);
+}
+
+int
+main(void)
+{
+    size_t i;
+    size_t j;
+    size_t k;
+
+    printf("benchmark,mode,producers,consumers,items,seconds,ops_per_sec\n");
+
+    for (i = 0; i < sizeof(modes) / sizeof(modes[0]); i++)
+      {
+          for (j = 0; j < sizeof(producerCounts) / sizeof(producerCounts[0]); j++)
+            {
+                for (k = 0; k < sizeof(consumerCounts) / sizeof(consumerCounts[0]); k++)
+                  {
+                      // The MPSC mode allows a single consumer
+                      if ((modes[i].flags & LIST_MPSC) && (consumerCounts[k] > 1))
+                        {
+                            continue;
+                        }
+
+                      bench_queue(&modes[i], producerCounts[j],
+                                  consumerCounts[k], 1);
+                      bench_queue(&modes[i], producerCounts[j],
+                                  consumerCounts[k], BATCH_SIZE);
+                  }
+            }
+      }
+
+    return 0;
+}
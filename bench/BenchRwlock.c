@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "Linked_list.h"
+#include "Harness.h"
+
+#define NUM_ELEMENTS        1000
+#define NUM_OPS             20000
+#define NUM_THREADS         4
+
+typedef struct bench_mode_t
+{
+    const char* name;
+    uint32_t flags;
+} bench_mode_t;
+
+static const bench_mode_t modes[] = {
+    {"mutex", 0},
+    {"rwlock", LIST_RWLOCK},
+};
+
+static const uint32_t readPercents[] = {50, 90, 99};
+
+static list_t l;
+static uint32_t readPercent;
+
+static void
+sum(const void* data, void* arg)
+{
+    *(uint64_t *) arg += *(const uint32_t *) data;
+}
+
+static void*
+worker(void* arg)
+{
+    uint32_t seed = (uint32_t) (uintptr_t) arg;
+    uint64_t total = 0;
+    uint32_t data;
+    uint32_t i;
+
+    for (i = 0; i < NUM_OPS; i++)
+      {
+          // Linear congruential generator, rand() takes a global lock
+          seed = seed * 1103515245u + 12345u;
+
+          if ((seed >> 16) % 100 < readPercent)
+            {
+                list_for_each(&l, sum, &total);
+            }
+          else
+            {
+                list_push(&l, (void *) &i);
+                list_pop_front(&l, (void *) &data);
+            }
+      }
+
+    return (void *) (uintptr_t) total;
+}
+
+static void
+bench_read_mix(const bench_mode_t* mode, uint32_t percent)
+{
+    pthread_t threads[NUM_THREADS];
+    list_config_t config = {0};
+    uint32_t i;
+    double start;
+    double elapsed;
+
+    config.flags = mode->flags;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          list_push(&l, (void *) &i);
+      }
+
+    readPercent = percent;
+
+    start = bench_now();
+
+    for (i = 0; i < NUM_THREADS; i++)
+      {
+          pthread_create(&threads[i], NULL, worker, (void *) (uintptr_t) (i + 1));
+      }
+
+    for (i = 0; i < NUM_THREADS; i++)
+      {
+          pthread_join(threads[i], NULL);
+      }
+
+    elapsed = bench_now() - start;
+
+    printf("read_mix,%s,%u,%u,%u,%.6f,%.0f\n", mode->name, NUM_THREADS, 
+           percent, NUM_THREADS * NUM_OPS, elapsed, 
+           NUM_THREADS * NUM_OPS / elapsed);
+
+    list_destroy(&l);
+}
+
+int
+main(void)
+{
+    size_t i;
+    size_t j;
+
+    printf("benchmark,mode,threads,read_percent,ops,seconds,ops_per_sec\n");
+
+    for (i = 0; i < sizeof(readPercents) / sizeof(readPercents[0]); i++)
+      {
+          for (j = 0; j < sizeof(modes) / sizeof(modes[0]); j++)
+            {
+                bench_read_mix(&modes[j], readPercents[i]);
+            }
+      }
+
+    return 0;
+}
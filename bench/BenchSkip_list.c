@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "Linked_list.h"
+#include "Skip_list.h"
+#include "Harness.h"
+
+#define NUM_ELEMENTS        1000000
+#define NUM_LOOKUPS         1000
+
+static void
+bench_list(void)
+{
+    list_t l;
+    uint32_t data;
+    uint32_t i;
+    double start;
+
+    list_init(&l, sizeof(uint32_t));
+
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          list_push(&l, (void *) &i);
+      }
+    bench_report("push", "list", NUM_ELEMENTS, bench_now() - start);
+
+    srand(1);
+    start = bench_now();
+    for (i = 0; i < NUM_LOOKUPS; i++)
+      {
+          list_get_by_index(&l, rand() % NUM_ELEMENTS, (void *) &data);
+      }
+    bench_report("get_by_index", "list", NUM_LOOKUPS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          list_get_by_index(&l, i, (void *) &data);
+      }
+    bench_report("get_by_index_seq", "list", NUM_ELEMENTS, bench_now() - start);
+
+    list_destroy(&l);
+}
+
+static void
+bench_skiplist(void)
+{
+    skiplist_t l;
+    uint32_t data;
+    uint32_t i;
+    double start;
+
+    skiplist_init(&l, sizeof(uint32_t));
+
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          skiplist_push(&l, (void *) &i);
+      }
+    bench_report("push", "skiplist", NUM_ELEMENTS, bench_now() - start);
+
+    srand(1);
+    start = bench_now();
+    for (i = 0; i < NUM_LOOKUPS; i++)
+      {
+          skiplist_get_by_index(&l, rand() % NUM_ELEMENTS, (void *) &data);
+      }
+    bench_report("get_by_index", "skiplist", NUM_LOOKUPS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          skiplist_get_by_index(&l, i, (void *) &data);
+      }
+    bench_report("get_by_index_seq", "skiplist", NUM_ELEMENTS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < NUM_LOOKUPS; i++)
+      {
+          skiplist_insert_at(&l, rand() % NUM_ELEMENTS, (void *) &i);
+          skiplist_remove_at(&l, rand() % NUM_ELEMENTS, (void *) &data);
+      }
+    bench_report("insert_remove_at", "skiplist", 2 * NUM_LOOKUPS, bench_now() - start);
+
+    skiplist_destroy(&l);
+}
+
+int
+main(void)
+{
+    printf("benchmark,structure,ops,seconds,ops_per_sec\n");
+
+    bench_list();
+    bench_skiplist();
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "Linked_list.h"
+#include "Harness.h"
+
+#define NUM_SIZES           3
+
+static const uint32_t sizes[NUM_SIZES] = {10000, 100000, 1000000};
+
+static void
+report(const char* benchmark, const char* method, uint32_t elements,
+       double elapsed)
+{
+    printf("%s,%s,%u,%.6f\n", benchmark, method, elements, elapsed);
+}
+
+static int
+compare(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t *) a;
+    uint32_t y = *(const uint32_t *) b;
+
+    return (x > y) - (x < y);
+}
+
+static void
+fill(list_t* l, uint32_t elements)
+{
+    uint32_t data;
+    uint32_t i;
+
+    srand(1);
+    for (i = 0; i < elements; i++)
+      {
+          data = (uint32_t) rand();
+          list_push(l, (void *) &data);
+      }
+}
+
+static void
+copy(const void* data, void* arg)
+{
+    uint32_t** out = arg;
+
+    **out = *(const uint32_t *) data;
+    (*out)++;
+}
+
+static void
+bench_list_sort(uint32_t elements)
+{
+    list_t l;
+    double start;
+
+    list_init(&l, sizeof(uint32_t));
+    fill(&l, elements);
+
+    start = bench_now();
+    list_sort(&l, compare);
+    report("sort", "list_sort", elements, bench_now() - start);
+
+    list_destroy(&l);
+}
+
+static void
+bench_qsort_rebuild(uint32_t elements)
+{
+    list_t l;
+    uint32_t* array = malloc(elements * sizeof(uint32_t));
+    uint32_t* out = array;
+    uint32_t i;
+    double start;
+
+    list_init(&l, sizeof(uint32_t));
+    fill(&l, elements);
+
+    start = bench_now();
+    list_for_each(&l, copy, (void *) &out);
+    list_free(&l);
+    qsort(array, elements, sizeof(uint32_t), compare);
+    for (i = 0; i < elements; i++)
+      {
+          list_push(&l, (void *) &array[i]);
+      }
+    report("sort", "qsort_rebuild", elements, bench_now() - start);
+
+    list_destroy(&l);
+    free(array);
+}
+
+static void
+bench_insert_sorted(uint32_t elements)
+{
+    list_t l;
+    uint32_t data;
+    uint32_t i;
+    double start;
+
+    // Sorted insertion is O(n) per element, keep the list small
+    elements /= 100;
+    list_init(&l, sizeof(uint32_t));
+
+    srand(1);
+    start = bench_now();
+    for (i = 0; i < elements; i++)
+      {
+          data = (uint32_t) rand();
+          list_insert_sorted(&l, compare, (void *) &data);
+      }
+    report("sort", "insert_sorted", elements, bench_now() - start);
+
+    list_destroy(&l);
+}
+
+int
+main(void)
+{
+    uint32_t i;
+
+    printf("benchmark,method,elements,seconds\n");
+
+    for (i = 0; i < NUM_SIZES; i++)
+      {
+          bench_list_sort(sizes[i]);
+          bench_qsort_rebuild(sizes[i]);
+          bench_insert_sorted(sizes[i]);
+      }
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "Linked_list.h"
+#include "Unrolled_list.h"
+#include "Harness.h"
+
+#define NUM_ELEMENTS        1000000
+#define NUM_ITERATIONS      10
+
+static void
+sum(const void* data, void* arg)
+{
+    *(int64_t *) arg += *(const int16_t *) data;
+}
+
+static void
+bench_list(void)
+{
+    list_t l;
+    int16_t data = 1;
+    int64_t total = 0;
+    uint32_t i;
+    double start;
+
+    list_init(&l, sizeof(int16_t));
+
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          list_push(&l, (void *) &data);
+      }
+    bench_report("push", "list", NUM_ELEMENTS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < NUM_ITERATIONS; i++)
+      {
+          list_for_each(&l, sum, (void *) &total);
+      }
+    bench_report("for_each", "list", NUM_ELEMENTS * NUM_ITERATIONS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          list_pop_front(&l, (void *) &data);
+      }
+    bench_report("pop_front", "list", NUM_ELEMENTS, bench_now() - start);
+
+    list_destroy(&l);
+}
+
+static void
+bench_ulist(void)
+{
+    ulist_t l;
+    int16_t data = 1;
+    int64_t total = 0;
+    uint32_t i;
+    double start;
+
+    ulist_init(&l, sizeof(int16_t));
+
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          ulist_push(&l, (void *) &data);
+      }
+    bench_report("push", "unrolled", NUM_ELEMENTS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < NUM_ITERATIONS; i++)
+      {
+          ulist_for_each(&l, sum, (void *) &total);
+      }
+    bench_report("for_each", "unrolled", NUM_ELEMENTS * NUM_ITERATIONS, 
+           bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          ulist_pop_front(&l, (void *) &data);
+      }
+    bench_report("pop_front", "unrolled", NUM_ELEMENTS, bench_now() - start);
+
+    ulist_destroy(&l);
+}
+
+int
+main(void)
+{
+    printf("benchmark,structure,ops,seconds,ops_per_sec\n");
+
+    bench_list();
+    bench_ulist();
+
+    return 0;
+}
@@ -0,0 +1,230 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "Linked_list.h"
+#include "Ws_deque.h"
+#include "Harness.h"
+
+#define NUM_ELEMENTS        1000000
+#define MAX_WORKERS         8
+#define NUM_TASKS           (1 << 16)
+#define WORK_ROUNDS         2000
+
+typedef struct
+{
+    uint32_t id;
+    uint32_t depth;
+} task_t;
+
+typedef struct
+{
+    uint32_t id;
+    uint32_t numWorkers;
+    wsdeque_t tasks;
+    uint64_t hash;
+} worker_t;
+
+static const uint32_t workerCounts[] = {1, 2, 4, 8};
+
+static worker_t workers[MAX_WORKERS];
+static list_t shared;
+static atomic_ullong pending;
+
+// Every task spawns two children until NUM_TASKS leaves have been reached
+static uint64_t
+run(const task_t* task, task_t children[2])
+{
+    uint64_t hash = task->id;
+    uint32_t i;
+
+    for (i = 0; i < WORK_ROUNDS; i++)
+      {
+          hash = hash * 6364136223846793005ULL + 1442695040888963407ULL;
+      }
+
+    if ((1u << task->depth) >= NUM_TASKS)
+      {
+          return hash;
+      }
+
+    children[0].id = task->id * 2;
+    children[1].id = task->id * 2 + 1;
+    children[0].depth = children[1].depth = task->depth + 1;
+    atomic_fetch_add(&pending, 2);
+
+    return hash;
+}
+
+static void*
+stealing_worker(void* arg)
+{
+    worker_t* self = (worker_t *) arg;
+    task_t children[2];
+    task_t task;
+    uint32_t victim = self->id;
+    uint32_t i;
+
+    while (atomic_load(&pending) > 0)
+      {
+          if (wsdeque_pop(&(self->tasks), (void *) &task))
+            {
+                for (i = 0; i < self->numWorkers; i++)
+                  {
+                      victim = (victim + 1) % self->numWorkers;
+                      if (wsdeque_steal(&(workers[victim].tasks),
+                                        (void *) &task) == 0)
+                        {
+                            break;
+                        }
+                  }
+                if (i == self->numWorkers)
+                  {
+                      continue;
+                  }
+            }
+
+          self->hash ^= run(&task, children);
+          if ((1u << task.depth) < NUM_TASKS)
+            {
+                wsdeque_push(&(self->tasks), (void *) &children[0]);
+                wsdeque_push(&(self->tasks), (void *) &children[1]);
+            }
+          atomic_fetch_sub(&pending, 1);
+      }
+
+    return NULL;
+}
+
+static void*
+shared_worker(void* arg)
+{
+    worker_t* self = (worker_t *) arg;
+    task_t children[2];
+    task_t task;
+
+    while (atomic_load(&pending) > 0)
+      {
+          if (list_pop(&shared, (void *) &task))
+            {
+                continue;
+            }
+
+          self->hash ^= run(&task, children);
+          if ((1u << task.depth) < NUM_TASKS)
+            {
+                list_push(&shared, (void *) &children[0]);
+                list_push(&shared, (void *) &children[1]);
+            }
+          atomic_fetch_sub(&pending, 1);
+      }
+
+    return NULL;
+}
+
+static void
+bench_pool(const char* structure, void* (*workerFn)(void* arg),
+           uint32_t numWorkers)
+{
+    pthread_t threads[MAX_WORKERS];
+    const task_t root = {1, 0};
+    uint32_t i;
+    double elapsed;
+    double start;
+
+    list_init(&shared, sizeof(task_t));
+    for (i = 0; i < numWorkers; i++)
+      {
+          workers[i].id = i;
+          workers[i].numWorkers = numWorkers;
+          workers[i].hash = 0;
+          wsdeque_init(&(workers[i].tasks), sizeof(task_t));
+      }
+
+    atomic_store(&pending, 1);
+    if (workerFn == shared_worker)
+      {
+          list_push(&shared, (void *) &root);
+      }
+    else
+      {
+          wsdeque_push(&(workers[0].tasks), (void *) &root);
+      }
+
+    start = bench_now();
+    for (i = 0; i < numWorkers; i++)
+      {
+          pthread_create(&threads[i], NULL, workerFn, (void *) &workers[i]);
+      }
+    for (i = 0; i < numWorkers; i++)
+      {
+          pthread_join(threads[i], NULL);
+      }
+    elapsed = bench_now() - start;
+
+    printf("pool,%s,%u,%u,%.6f,%.0f\n", structure, numWorkers,
+           2 * NUM_TASKS - 1, elapsed, (2 * NUM_TASKS - 1) / elapsed);
+
+    for (i = 0; i < numWorkers; i++)
+      {
+          wsdeque_destroy(&(workers[i].tasks));
+      }
+    list_destroy(&shared);
+}
+
+static void
+bench_owner(void)
+{
+    wsdeque_t dq;
+    list_t l;
+    uint32_t i;
+    double elapsed;
+    double start;
+
+    wsdeque_init(&dq, sizeof(uint32_t));
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          wsdeque_push(&dq, (void *) &i);
+      }
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          wsdeque_pop(&dq, (void *) &i);
+      }
+    elapsed = bench_now() - start;
+    printf("push_pop,wsdeque,1,%u,%.6f,%.0f\n", 2 * NUM_ELEMENTS, elapsed,
+           2 * NUM_ELEMENTS / elapsed);
+    wsdeque_destroy(&dq);
+
+    list_init(&l, sizeof(uint32_t));
+    start = bench_now();
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          list_push(&l, (void *) &i);
+      }
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          list_pop_front(&l, (void *) &i);
+      }
+    elapsed = bench_now() - start;
+    printf("push_pop,list,1,%u,%.6f,%.0f\n", 2 * NUM_ELEMENTS, elapsed,
+           2 * NUM_ELEMENTS / elapsed);
+    list_destroy(&l);
+}
+
+int
+main(void)
+{
+    size_t i;
+
+    printf("benchmark,structure,threads,ops,seconds,ops_per_sec\n");
+
+    bench_owner();
+
+    for (i = 0; i < sizeof(workerCounts) / sizeof(workerCounts[0]); i++)
+      {
+          bench_pool("wsdeque", stealing_worker, workerCounts[i]);
+          bench_pool("list", shared_worker, workerCounts[i]);
+      }
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <stdlib.h>
+#include <time.h>
+#include "Harness.h"
+
+static int
+compare_u64(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+
+    return (x > y) - (x < y);
+}
+
+static uint64_t
+percentile(const bench_latency_t* latency, uint32_t perMille)
+{
+    size_t rank = (latency->numSamples * perMille) / 1000;
+
+    if (rank >= latency->numSamples)
+      {
+          rank = latency->numSamples - 1;
+      }
+
+    return latency->samples[rank];
+}
+
+double
+bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+uint64_t
+bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+void
+bench_report(const char* benchmark, const char* structure, uint32_t ops,
+             double elapsed)
+{
+    printf("%s,%s,%u,%.6f,%.0f\n", benchmark, structure, ops, elapsed,
+           ops / elapsed);
+}
+
+void
+bench_latency_init(bench_latency_t* latency, size_t capacity)
+{
+    latency->samples = malloc(capacity * sizeof(uint64_t));
+    latency->numSamples = 0;
+    latency->capacity = capacity;
+}
+
+void
+bench_latency_free(bench_latency_t* latency)
+{
+    free(latency->samples);
+    latency->samples = NULL;
+    latency->numSamples = 0;
+    latency->capacity = 0;
+}
+
+void
+bench_latency_add(bench_latency_t* latency, uint64_t ns)
+{
+    // Samples beyond the capacity are dropped
+    if (latency->numSamples < latency->capacity)
+      {
+          latency->samples[latency->numSamples++] = ns;
+      }
+}
+
+void
+bench_latency_report(bench_latency_t* latency, const char* benchmark,
+                     const char* mode, uint32_t threads)
+{
+    if (latency->numSamples == 0)
+      {
+          return;
+      }
+
+    qsort(latency->samples, latency->numSamples, sizeof(uint64_t),
+          compare_u64);
+
+    printf("%s,%s,%u,%zu,%lu,%lu,%lu,%lu\n", benchmark, mode, threads,
+           latency->numSamples,
+           (unsigned long) percentile(latency, 500),
+           (unsigned long) percentile(latency, 990),
+           (unsigned long) percentile(latency, 999),
+           (unsigned long) latency->samples[latency->numSamples - 1]);
+}
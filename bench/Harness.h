@@ -0,0 +1,29 @@
+#ifndef HARNESS_H
+#define HARNESS_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Latency samples of a benchmark in nanoseconds. The samples are recorded
+ * with bench_latency_add and summarized with bench_latency_report.
+ */
+typedef struct bench_latency_t
+{
+    uint64_t* samples;
+    size_t numSamples;
+    size_t capacity;
+} bench_latency_t;
+
+double bench_now(void);
+uint64_t bench_now_ns(void);
+void bench_report(const char* benchmark, const char* structure, uint32_t ops,
+                  double elapsed);
+void bench_latency_init(bench_latency_t* latency, size_t capacity);
+void bench_latency_free(bench_latency_t* latency);
+void bench_latency_add(bench_latency_t* latency, uint64_t ns);
+void bench_latency_report(bench_latency_t* latency, const char* benchmark,
+                          const char* mode, uint32_t threads);
+
+#endif /* HARNESS_H */
@@ -0,0 +1,789 @@
+/******************************************************************************
+* Title                 :   Deque source file
+* Filename              :   Deque.c
+* Author                :   Maximiliano Valencia
+* Origin Date           :   09/02/2019
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   STM32
+* Notes                 :   None
+******************************************************************************/
+/*! @file Deque.c
+ *  @brief Ring buffer deque implementation
+ *
+ *  To use the deque implementation, include this header file as follows:
+ *  @code
+ *  #include "Deque.h"
+ *  @endcode
+ *
+ *  ## Overview ##
+ *  A Deque offers the same methods as the Linked List (see Linked_list.h)
+ *  but stores the elements contiguously in a ring buffer instead of one node
+ *  per element. Pushing and popping at both ends are O(1) without allocating
+ *  memory, except when the buffer is full and its capacity is doubled, and
+ *  deque_get_by_index is O(1) because the slot of any element is computed
+ *  from its index.
+ *
+ *  ## Usage ##
+ *
+ *  The following code example initializes the deque, writes to it and then
+ *  gets elements from it.
+ *
+ *  @code
+ *      int data;
+ *      deque_t dq;
+ *
+ *      deque_init(&dq, sizeof(int));
+ *
+ *      data = 4;
+ *      deque_push(&dq, (void *) &data);
+ *      data = 17;
+ *      deque_push_front(&dq, (void *) &data);
+ *
+ *      deque_get_by_index(&dq, 1, (void *) &data);
+ *      printf("Value at position 1: %d\n", data);
+ *
+ *      deque_destroy(&dq);
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+******************************************************************************/
+#include "Deque.h"              /* Deque structure typedef */
+
+/******************************************************************************
+* Module Preprocessor Constants
+******************************************************************************/
+
+
+/******************************************************************************
+* Module Preprocessor Macros
+******************************************************************************/
+/**
+ * Pointer to the slot of the element at a given index
+ */
+#define DEQUE_SLOT(deque, index)    ((deque)->buffer + \
+                                     (((deque)->head + (index)) & \
+                                      ((deque)->capacity - 1)) * \
+                                     (deque)->dataSize)
+
+
+/******************************************************************************
+* Module Typedefs
+******************************************************************************/
+
+
+/******************************************************************************
+* Module Variable Definitions
+******************************************************************************/
+
+
+/******************************************************************************
+* Function Prototypes
+******************************************************************************/
+static void grow_buffer(deque_t* deque);
+static void _deque_push(deque_t* deque, const void* data);
+static void _deque_push_front(deque_t* deque, const void* data);
+static uint8_t _deque_pop(deque_t* deque, void* data);
+static uint8_t _deque_pop_front(deque_t* deque, void* data);
+static uint8_t _deque_get_by_index(deque_t* deque, size_t index, void* data);
+static void _deque_for_each(deque_t* deque, void (*eachFn)(const void* data, void* arg), void* arg);
+static void _deque_for_each_reverse(deque_t* deque, void (*eachFn)(const void* data, void* arg), void* arg);
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+
+
+/*****************************************************************************/
+/*!
+ *
+ * @addtogroup deque
+ * @{
+ *
+ */
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to double the capacity of the buffer of the deque.
+ * The elements are copied to the start of the new buffer, unwrapping the
+ * ring with at most two copies. This function is private and it must only
+ * be used by internal methods.
+ *
+ * @param deque Deque.
+ *
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+grow_buffer(deque_t* deque)
+{
+    size_t newCapacity = (deque->capacity > 0) ? 2 * deque->capacity :
+                                                 DEQUE_INITIAL_CAPACITY;
+    size_t numElements = deque->numElements;
+    size_t firstPart;
+    unsigned char* buffer;
+
+    buffer = (unsigned char *) malloc(newCapacity * deque->dataSize);
+
+    if (numElements > 0)
+      {
+          // Elements from the head to the end of the buffer, then the ones
+          // wrapped around to its start
+          firstPart = deque->capacity - deque->head;
+          if (firstPart > numElements)
+            {
+                firstPart = numElements;
+            }
+
+          memcpy(buffer, DEQUE_SLOT(deque, 0), firstPart * deque->dataSize);
+          memcpy(buffer + firstPart * deque->dataSize, deque->buffer,
+                 (numElements - firstPart) * deque->dataSize);
+      }
+
+    free(deque->buffer);
+    deque->buffer = buffer;
+    deque->capacity = newCapacity;
+    deque->head = 0;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to intialize a deque structure with a buffer of
+ * DEQUE_INITIAL_CAPACITY elements.
+ *
+ * @param deque Deque to be initialized.
+ * @param dataSize Size of the data of the elements.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      deque_t deque;
+ *      deque_init(&deque, sizeof(uint32_t));
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+deque_init(deque_t* deque, size_t dataSize)
+{
+    deque_init_capacity(deque, dataSize, DEQUE_INITIAL_CAPACITY);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to intialize a deque structure with a buffer of at
+ * least a given number of elements, rounded up to a power of two, so that
+ * the buffer doesn't grow while the deque holds fewer elements.
+ *
+ * @param deque Deque to be initialized.
+ * @param dataSize Size of the data of the elements.
+ * @param capacity Number of elements of the buffer.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      deque_t deque;
+ *      deque_init_capacity(&deque, sizeof(uint32_t), 1024);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+deque_init_capacity(deque_t* deque, size_t dataSize, size_t capacity)
+{
+    size_t slots = 1;
+
+    while (slots < capacity)
+      {
+          slots <<= 1;
+      }
+
+    atomic_init(&(deque->numElements), 0);
+    deque->dataSize = dataSize;
+    deque->capacity = slots;
+    deque->head = 0;
+    deque->buffer = (unsigned char *) malloc(slots * dataSize);
+
+    // The mutex is used to avoid working with a busy deque
+    pthread_mutex_init(&(deque->lock), NULL);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to release the memory of the deque elements. The
+ * deque can still be used, the buffer is allocated again by the next push.
+ *
+ * @param deque Deque to free the memory of its elements.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      deque_free(&deque);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+deque_free(deque_t* deque)
+{
+    free(deque->buffer);
+
+    deque->buffer = NULL;
+    deque->capacity = 0;
+    deque->head = 0;
+    atomic_store(&(deque->numElements), 0);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to free the memory of the deque elements and of the
+ * mutex.
+ *
+ * @param deque Deque to free the memory of the elements and mutex.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      deque_destroy(&deque);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+deque_destroy(deque_t* deque)
+{
+    deque_free(deque);
+    pthread_mutex_destroy(&(deque->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to add an element to the end of the deque.
+ *
+ * @param deque Deque.
+ * @param data Pointer to the variable which value will be inserted at the end
+ *             of the deque.
+ *
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_deque_push(deque_t* deque, const void* data)
+{
+    if (deque->numElements == deque->capacity)
+      {
+          grow_buffer(deque);
+      }
+
+    memcpy(DEQUE_SLOT(deque, deque->numElements), data, deque->dataSize);
+    deque->numElements++;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to add an element to the end of the deque.
+ *
+ * @param deque Deque.
+ * @param data Pointer to the variable which value will be inserted at the end
+ *             of the deque.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      deque_push(&deque, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+deque_push(deque_t* deque, const void* data)
+{
+    pthread_mutex_lock(&(deque->lock));
+        _deque_push(deque, data);
+    pthread_mutex_unlock(&(deque->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to add an element to the front of the deque.
+ *
+ * @param deque Deque.
+ * @param data Pointer to the variable which value will be inserted at the
+ *             front of the deque.
+ *
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_deque_push_front(deque_t* deque, const void* data)
+{
+    if (deque->numElements == deque->capacity)
+      {
+          grow_buffer(deque);
+      }
+
+    deque->head = (deque->head - 1) & (deque->capacity - 1);
+    memcpy(DEQUE_SLOT(deque, 0), data, deque->dataSize);
+    deque->numElements++;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to add an element to the front of the deque.
+ *
+ * @param deque Deque.
+ * @param data Pointer to the variable which value will be inserted at the
+ *             front of the deque.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      deque_push_front(&deque, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+deque_push_front(deque_t* deque, const void* data)
+{
+    pthread_mutex_lock(&(deque->lock));
+        _deque_push_front(deque, data);
+    pthread_mutex_unlock(&(deque->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to get and delete the element at the end of the
+ * deque.
+ *
+ * @param deque Deque.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element at the end of the deque.
+ *
+ * @return 1 if there are no elements, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_deque_pop(deque_t* deque, void* data)
+{
+    // If the deque is empty, return error
+    if (deque->numElements == 0)
+      {
+          return 1;
+      }
+
+    deque->numElements--;
+    memcpy(data, DEQUE_SLOT(deque, deque->numElements), deque->dataSize);
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get and delete the element at the end of the
+ * deque.
+ *
+ * @param deque Deque.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element at the end of the deque.
+ *
+ * @return 1 if there are no elements, 0 otherwise.
+ *
+ * \b Example:
+ * @code
+ *      uint8_t error = deque_pop(&deque, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+deque_pop(deque_t* deque, void* data)
+{
+    uint8_t retval;
+
+    pthread_mutex_lock(&(deque->lock));
+        retval = _deque_pop(deque, data);
+    pthread_mutex_unlock(&(deque->lock));
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to get and delete the element at the front of the
+ * deque.
+ *
+ * @param deque Deque.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element at the front of the deque.
+ *
+ * @return 1 if there are no elements, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_deque_pop_front(deque_t* deque, void* data)
+{
+    // If the deque is empty, return error
+    if (deque->numElements == 0)
+      {
+          return 1;
+      }
+
+    memcpy(data, DEQUE_SLOT(deque, 0), deque->dataSize);
+    deque->head = (deque->head + 1) & (deque->capacity - 1);
+    deque->numElements--;
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get and delete the element at the front of the
+ * deque.
+ *
+ * @param deque Deque.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element at the front of the deque.
+ *
+ * @return 1 if there are no elements, 0 otherwise.
+ *
+ * \b Example:
+ * @code
+ *      uint8_t error = deque_pop_front(&deque, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+deque_pop_front(deque_t* deque, void* data)
+{
+    uint8_t retval;
+
+    pthread_mutex_lock(&(deque->lock));
+        retval = _deque_pop_front(deque, data);
+    pthread_mutex_unlock(&(deque->lock));
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to get the value of the element at a given index.
+ * It doesn't delete the element.
+ *
+ * @param deque Deque.
+ * @param index Index of the element.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element at the given index.
+ *
+ * @return 1 if the given index is out of limits, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_deque_get_by_index(deque_t* deque, size_t index, void* data)
+{
+    // Check if index is between limits of the deque
+    if (index >= deque->numElements)
+      {
+          return 1;
+      }
+
+    memcpy(data, DEQUE_SLOT(deque, index), deque->dataSize);
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get the value of the element at a given index in
+ * constant time. It doesn't delete the element.
+ *
+ * @param deque Deque.
+ * @param index Index of the element.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element at the given index.
+ *
+ * @return 1 if the given index is out of limits, 0 otherwise.
+ *
+ * \b Example:
+ * @code
+ *      uint8_t error = deque_get_by_index(&deque, 3, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+deque_get_by_index(deque_t* deque, size_t index, void* data)
+{
+    uint8_t retval;
+
+    pthread_mutex_lock(&(deque->lock));
+        retval = _deque_get_by_index(deque, index, data);
+    pthread_mutex_unlock(&(deque->lock));
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to call a function for every element of the deque,
+ * from the front to the end.
+ *
+ * @param deque Deque.
+ * @param eachFn Pointer to the function called for every element.
+ * @param arg Argument passed to eachFn.
+ *
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_deque_for_each(deque_t* deque,
+                void (*eachFn)(const void* data, void* arg),
+                void* arg)
+{
+    size_t i;
+
+    for (i = 0; i < deque->numElements; i++)
+      {
+          eachFn(DEQUE_SLOT(deque, i), arg);
+      }
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to call a function for every element of the deque,
+ * from the end to the front.
+ *
+ * @param deque Deque.
+ * @param eachFn Pointer to the function called for every element.
+ * @param arg Argument passed to eachFn.
+ *
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_deque_for_each_reverse(deque_t* deque,
+                        void (*eachFn)(const void* data, void* arg),
+                        void* arg)
+{
+    size_t i;
+
+    for (i = deque->numElements; i > 0; i--)
+      {
+          eachFn(DEQUE_SLOT(deque, i - 1), arg);
+      }
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to print the values of the deque.
+ *
+ * @param deque Deque.
+ * @param printFn Pointer to the function used to print the elements.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      deque_print(&deque, printInt);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+deque_print(deque_t* deque, void (*printFn)(const void* data))
+{
+    size_t i;
+
+    pthread_mutex_lock(&(deque->lock));
+        for (i = 0; i < deque->numElements; i++)
+          {
+              printFn(DEQUE_SLOT(deque, i));
+          }
+        printf("\n");
+    pthread_mutex_unlock(&(deque->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to call a function for every element of the deque,
+ * from the front to the end.
+ *
+ * @param deque Deque.
+ * @param eachFn Pointer to the function called for every element. It
+ *               receives a pointer to the element and arg.
+ * @param arg Argument passed to eachFn.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      deque_for_each(&deque, sum, (void *) &total);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+deque_for_each(deque_t* deque,
+               void (*eachFn)(const void* data, void* arg),
+               void* arg)
+{
+    pthread_mutex_lock(&(deque->lock));
+        _deque_for_each(deque, eachFn, arg);
+    pthread_mutex_unlock(&(deque->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to call a function for every element of the deque,
+ * from the end to the front.
+ *
+ * @param deque Deque.
+ * @param eachFn Pointer to the function called for every element. It
+ *               receives a pointer to the element and arg.
+ * @param arg Argument passed to eachFn.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      deque_for_each_reverse(&deque, sum, (void *) &total);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+deque_for_each_reverse(deque_t* deque,
+                       void (*eachFn)(const void* data, void* arg),
+                       void* arg)
+{
+    pthread_mutex_lock(&(deque->lock));
+        _deque_for_each_reverse(deque, eachFn, arg);
+    pthread_mutex_unlock(&(deque->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get the number of elements in the deque. The
+ * number of elements is an atomic counter, so the lock is not taken.
+ *
+ * @param deque Deque.
+ *
+ * @return Number of elements in the deque.
+ *
+ * \b Example:
+ * @code
+ *      size_t dequeSize = deque_size(&deque);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+size_t
+deque_size(deque_t* deque)
+{
+    return atomic_load_explicit(&(deque->numElements), memory_order_relaxed);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * Close the Doxygen group.
+ * @}
+ *
+ */
+/*****************************************************************************/
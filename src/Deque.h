@@ -0,0 +1,98 @@
+/******************************************************************************
+* Title                 :   Deque header file
+* Filename              :   Deque.h
+* Author                :   Maximiliano Valencia
+* Origin Date           :   09/02/2019
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   STM32
+* Notes                 :   None
+******************************************************************************/
+/** @file Deque.h
+ *  @brief Defines the prototypes of the ring buffer deque.
+ *
+ *  This is the header file for the definition of the deque structure and
+ *  typedef as well as the function prototypes of the methods of the deque.
+ *  The methods have the same names and behaviour as the ones of the linked
+ *  list (see Linked_list.h) with the deque_ prefix.
+ */
+#ifndef DEQUE_H
+#define DEQUE_H
+
+/******************************************************************************
+* Includes
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+/******************************************************************************
+* Preprocessor Constants
+******************************************************************************/
+/**
+ * Number of elements the buffer of a deque can hold after deque_init
+ */
+#define DEQUE_INITIAL_CAPACITY  16
+
+
+/******************************************************************************
+* Configuration Constants
+******************************************************************************/
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+/**
+ * Deque type definition
+ */
+typedef struct deque_t deque_t;
+
+/*! @brief Deque structure definition
+ *
+ *  The elements are stored contiguously in a ring buffer whose capacity is
+ *  a power of two. The element at index i is stored at the slot
+ *  (head + i) & (capacity - 1), and the buffer doubles its capacity when it
+ *  is full.
+ */
+struct deque_t
+{
+    atomic_size_t numElements; /**< Number of elements in the deque */
+    size_t dataSize;        /**< Size of data of the elements */
+    size_t capacity;        /**< Number of slots of the buffer */
+    size_t head;            /**< Slot of the element at the front */
+    unsigned char* buffer;  /**< Slots of the elements */
+    pthread_mutex_t lock;   /**< Mutex used to lock the deque */
+};
+
+/******************************************************************************
+* Variables
+******************************************************************************/
+
+
+/******************************************************************************
+* Function Prototypes
+******************************************************************************/
+void deque_init(deque_t* deque, size_t dataSize);
+void deque_init_capacity(deque_t* deque, size_t dataSize, size_t capacity);
+void deque_free(deque_t* deque);
+void deque_destroy(deque_t* deque);
+void deque_push(deque_t* deque, const void* data);
+void deque_push_front(deque_t* deque, const void* data);
+uint8_t deque_pop(deque_t* deque, void* data);
+uint8_t deque_pop_front(deque_t* deque, void* data);
+uint8_t deque_get_by_index(deque_t* deque, size_t index, void* data);
+void deque_print(deque_t* deque, void (*printFn)(const void* data));
+void deque_for_each(deque_t* deque, void (*eachFn)(const void* data, void* arg), void* arg);
+void deque_for_each_reverse(deque_t* deque, void (*eachFn)(const void* data, void* arg), void* arg);
+size_t deque_size(deque_t* deque);
+
+#endif /* DEQUE_H */
@@ -0,0 +1,561 @@
+/******************************************************************************
+* Title                 :   Intrusive linked list source file
+* Filename              :   Intrusive_list.c
+* Author                :   Maximiliano Valencia
+* Origin Date           :   09/02/2019
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   STM32
+* Notes                 :   None
+******************************************************************************/
+/*! @file Intrusive_list.c
+ *  @brief Intrusive linked list implementation
+ *
+ *  To use the intrusive linked list implementation, include this header file
+ *  as follows:
+ *  @code
+ *  #include "Intrusive_list.h"
+ *  @endcode
+ *
+ *  ## Overview ##
+ *  An Intrusive Linked List doesn't allocate nodes nor copy the elements.
+ *  The caller embeds a link (ilist_link_t) in its own objects, which can live in
+ *  a pool, and the list only threads the pointers of the links. The object
+ *  that embeds a link is recovered with ILIST_ENTRY. The objects belong to 
+ *  the caller, they must stay valid while they are in a list and the list 
+ *  never frees them.
+ *
+ *  The links are doubly linked, so besides the methods of the Linked List 
+ *  (see Linked_list.h) an object can be removed from the middle of the list
+ *  in constant time.
+ *
+ *  ## Usage ##
+ *
+ *  The following code example initializes the intrusive linked list, adds an
+ *  object to it and then gets it back.
+ *
+ *  @code
+ *      typedef struct
+ *      {
+ *          uint32_t id;
+ *          ilist_link_t link;
+ *      } job_t;
+ *
+ *      job_t job = {.id = 4};
+ *      ilist_link_t* link;
+ *      ilist_t il;
+ *
+ *      ilist_init(&il);
+ *
+ *      ilist_push(&il, &job.link);
+ *
+ *      link = ilist_pop_front(&il);
+ *      printf("Job: %u\n", ILIST_ENTRY(link, job_t, link)->id);
+ *
+ *      ilist_destroy(&il);
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+******************************************************************************/
+#include "Intrusive_list.h"     /* Link and intrusive list typedefs */
+
+/******************************************************************************
+* Module Preprocessor Constants
+******************************************************************************/
+
+
+/******************************************************************************
+* Module Preprocessor Macros
+******************************************************************************/
+
+
+/******************************************************************************
+* Module Typedefs
+******************************************************************************/
+
+
+/******************************************************************************
+* Module Variable Definitions
+******************************************************************************/
+
+
+/******************************************************************************
+* Function Prototypes
+******************************************************************************/
+static void _ilist_push(ilist_t* list, ilist_link_t* link);
+static void _ilist_push_front(ilist_t* list, ilist_link_t* link);
+static void _ilist_remove(ilist_t* list, ilist_link_t* link);
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+
+
+/*****************************************************************************/
+/*!
+ *
+ * @addtogroup intrusive_list
+ * @{
+ *
+ */
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to intialize an intrusive linked list structure.
+ *
+ * @param list Intrusive list to be initialized.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      ilist_t list;
+ *      ilist_init(&list);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+ilist_init(ilist_t* list)
+{
+    atomic_init(&(list->numElements), 0);
+    list->head = NULL;
+    list->tail = NULL;
+
+    // The mutex is used to avoid working with a busy list
+    pthread_mutex_init(&(list->lock), NULL);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to unlink every element of the list. The objects 
+ * are not freed, they belong to the caller.
+ *
+ * @param list Intrusive list.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      ilist_clear(&list);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+ilist_clear(ilist_t* list)
+{
+    ilist_link_t* link;
+    ilist_link_t* next;
+
+    pthread_mutex_lock(&(list->lock));
+        for (link = list->head; link != NULL; link = next)
+          {
+              next = link->next;
+              link->next = NULL;
+              link->prev = NULL;
+          }
+
+        list->head = NULL;
+        list->tail = NULL;
+        atomic_store_explicit(&(list->numElements), 0, memory_order_relaxed);
+    pthread_mutex_unlock(&(list->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to unlink every element of the list and free the 
+ * memory of the mutex.
+ *
+ * @param list Intrusive list.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      ilist_destroy(&list);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+ilist_destroy(ilist_t* list)
+{
+    ilist_clear(list);
+    pthread_mutex_destroy(&(list->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to link an element at the end of the list.
+ *
+ * @param list Intrusive list.
+ * @param link Link embedded in the object.
+ *
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_ilist_push(ilist_t* list, ilist_link_t* link)
+{
+    link->next = NULL;
+    link->prev = list->tail;
+
+    if (list->tail != NULL)
+      {
+          list->tail->next = link;
+      }
+    else
+      {
+          list->head = link;
+      }
+    list->tail = link;
+
+    atomic_store_explicit(&(list->numElements), 
+                          atomic_load_explicit(&(list->numElements), 
+                                               memory_order_relaxed) + 1, 
+                          memory_order_relaxed);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to add an element to the end of the list. The link
+ * must not be in another list.
+ *
+ * @param list Intrusive list.
+ * @param link Link embedded in the object.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      ilist_push(&list, &job->link);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+ilist_push(ilist_t* list, ilist_link_t* link)
+{
+    pthread_mutex_lock(&(list->lock));
+        _ilist_push(list, link);
+    pthread_mutex_unlock(&(list->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to link an element at the front of the list.
+ *
+ * @param list Intrusive list.
+ * @param link Link embedded in the object.
+ *
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_ilist_push_front(ilist_t* list, ilist_link_t* link)
+{
+    link->prev = NULL;
+    link->next = list->head;
+
+    if (list->head != NULL)
+      {
+          list->head->prev = link;
+      }
+    else
+      {
+          list->tail = link;
+      }
+    list->head = link;
+
+    atomic_store_explicit(&(list->numElements), 
+                          atomic_load_explicit(&(list->numElements), 
+                                               memory_order_relaxed) + 1, 
+                          memory_order_relaxed);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to add an element to the front of the list. The 
+ * link must not be in another list.
+ *
+ * @param list Intrusive list.
+ * @param link Link embedded in the object.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      ilist_push_front(&list, &job->link);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+ilist_push_front(ilist_t* list, ilist_link_t* link)
+{
+    pthread_mutex_lock(&(list->lock));
+        _ilist_push_front(list, link);
+    pthread_mutex_unlock(&(list->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to unlink an element of the list.
+ *
+ * @param list Intrusive list.
+ * @param link Link of an element of the list.
+ *
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_ilist_remove(ilist_t* list, ilist_link_t* link)
+{
+    if (link->prev != NULL)
+      {
+          link->prev->next = link->next;
+      }
+    else
+      {
+          list->head = link->next;
+      }
+
+    if (link->next != NULL)
+      {
+          link->next->prev = link->prev;
+      }
+    else
+      {
+          list->tail = link->prev;
+      }
+
+    link->next = NULL;
+    link->prev = NULL;
+
+    atomic_store_explicit(&(list->numElements), 
+                          atomic_load_explicit(&(list->numElements), 
+                                               memory_order_relaxed) - 1, 
+                          memory_order_relaxed);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get and unlink the element at the end of the 
+ * list.
+ *
+ * @param list Intrusive list.
+ *
+ * @return Link of the element, NULL if the list is empty.
+ *
+ * \b Example:
+ * @code
+ *      ilist_link_t* link = ilist_pop(&list);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+ilist_link_t*
+ilist_pop(ilist_t* list)
+{
+    ilist_link_t* link;
+
+    pthread_mutex_lock(&(list->lock));
+        link = list->tail;
+        if (link != NULL)
+          {
+              _ilist_remove(list, link);
+          }
+    pthread_mutex_unlock(&(list->lock));
+
+    return link;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get and unlink the element at the front of the 
+ * list.
+ *
+ * @param list Intrusive list.
+ *
+ * @return Link of the element, NULL if the list is empty.
+ *
+ * \b Example:
+ * @code
+ *      ilist_link_t* link = ilist_pop_front(&list);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+ilist_link_t*
+ilist_pop_front(ilist_t* list)
+{
+    ilist_link_t* link;
+
+    pthread_mutex_lock(&(list->lock));
+        link = list->head;
+        if (link != NULL)
+          {
+              _ilist_remove(list, link);
+          }
+    pthread_mutex_unlock(&(list->lock));
+
+    return link;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to unlink an element from any position of the list
+ * in constant time. A link that is not in any list, because it was already
+ * popped or removed or it was zero-initialized and never pushed, is 
+ * rejected. The link must not be in another list, which is only detected if
+ * it is its first element.
+ *
+ * @param list Intrusive list.
+ * @param link Link of an element of the list.
+ *
+ * @return 1 if the link is not in the list, 0 otherwise.
+ *
+ * \b Example:
+ * @code
+ *      uint8_t error = ilist_remove(&list, &job->link);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+ilist_remove(ilist_t* list, ilist_link_t* link)
+{
+    uint8_t retval = 0;
+
+    pthread_mutex_lock(&(list->lock));
+        // Only the first element of the list has no previous link
+        if (link->prev == NULL && list->head != link)
+          {
+              retval = 1;
+          }
+        else
+          {
+              _ilist_remove(list, link);
+          }
+    pthread_mutex_unlock(&(list->lock));
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to call a function for every element of the list,
+ * from the front to the end. The function can modify the objects but must 
+ * not unlink them.
+ *
+ * @param list Intrusive list.
+ * @param eachFn Pointer to the function called for every element. It
+ *               receives the link of the element and arg.
+ * @param arg Argument passed to eachFn.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      ilist_for_each(&list, runJob, NULL);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+ilist_for_each(ilist_t* list,
+               void (*eachFn)(ilist_link_t* link, void* arg),
+               void* arg)
+{
+    ilist_link_t* link;
+
+    pthread_mutex_lock(&(list->lock));
+        for (link = list->head; link != NULL; link = link->next)
+          {
+              eachFn(link, arg);
+          }
+    pthread_mutex_unlock(&(list->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get the number of elements in the list. The
+ * number of elements is an atomic counter, so the lock is not taken.
+ *
+ * @param list Intrusive list.
+ *
+ * @return Number of elements in the list.
+ *
+ * \b Example:
+ * @code
+ *      size_t listSize = ilist_size(&list);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+size_t
+ilist_size(ilist_t* list)
+{
+    return atomic_load_explicit(&(list->numElements), memory_order_relaxed);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * Close the Doxygen group.
+ * @}
+ *
+ */
+/*****************************************************************************/
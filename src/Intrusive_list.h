@@ -0,0 +1,103 @@
+/******************************************************************************
+* Title                 :   Intrusive linked list header file
+* Filename              :   Intrusive_list.h
+* Author                :   Maximiliano Valencia
+* Origin Date           :   09/02/2019
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   STM32
+* Notes                 :   None
+******************************************************************************/
+/** @file Intrusive_list.h
+ *  @brief Defines the prototypes of the intrusive linked list.
+ *
+ *  This is the header file for the definition of the link and intrusive 
+ *  linked list structures and typedefs as well as the function prototypes of
+ *  the methods of the intrusive linked list.
+ */
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+/******************************************************************************
+* Includes
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+/******************************************************************************
+* Preprocessor Constants
+******************************************************************************/
+
+
+/******************************************************************************
+* Configuration Constants
+******************************************************************************/
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+/**
+ * Pointer to the object that embeds a link, given the type of the object and
+ * the name of the link member
+ */
+#define ILIST_ENTRY(link, type, member)  \
+    ((type *) ((unsigned char *) (link) - offsetof(type, member)))
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+/**
+ * Intrusive linked list type definition
+ */
+typedef struct ilist_t ilist_t;
+/**
+ * Link type definition
+ */
+typedef struct ilist_link_t ilist_link_t;
+
+/*! @brief Link structure definition
+ *
+ *  The link is embedded by the caller in its own objects. An object can be 
+ *  in as many lists at the same time as links it embeds.
+ */
+struct ilist_link_t
+{
+    ilist_link_t* next;     /**< Pointer to the next link */
+    ilist_link_t* prev;     /**< Pointer to the previous link */
+};
+
+/*! @brief Intrusive linked list structure definition */
+struct ilist_t
+{
+    atomic_size_t numElements; /**< Number of elements in the list */
+    ilist_link_t* head;     /**< Pointer to the first link */
+    ilist_link_t* tail;     /**< Pointer to the last link */
+    pthread_mutex_t lock;   /**< Mutex used to lock the list */
+};
+
+/******************************************************************************
+* Variables
+******************************************************************************/
+
+
+/******************************************************************************
+* Function Prototypes
+******************************************************************************/
+void ilist_init(ilist_t* list);
+void ilist_clear(ilist_t* list);
+void ilist_destroy(ilist_t* list);
+void ilist_push(ilist_t* list, ilist_link_t* link);
+void ilist_push_front(ilist_t* list, ilist_link_t* link);
+ilist_link_t* ilist_pop(ilist_t* list);
+ilist_link_t* ilist_pop_front(ilist_t* list);
+uint8_t ilist_remove(ilist_t* list, ilist_link_t* link);
+void ilist_for_each(ilist_t* list, void (*eachFn)(ilist_link_t* link, void* arg), void* arg);
+size_t ilist_size(ilist_t* list);
+
+#endif /* INTRUSIVE_LIST_H */
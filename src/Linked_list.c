@@ -22,6 +22,51 @@
  *  First Out (LIFO) memory but methods to push and pop to the front of the 
  *  list are also implemented.
  * 
+ *  By default the list is singly linked and list_pop has to walk the list to
+ *  find the new tail. Lists initialized with the LIST_DOUBLY_LINKED flag keep
+ *  a pointer to the previous node, which makes list_pop O(1) and allows to 
+ *  iterate the list in reverse order.
+ * 
+ *  Lists initialized with the LIST_MPSC flag work as a lock-free multi-
+ *  producer single-consumer queue: any number of threads call list_push
+ *  without taking the lock while a consumer drains the list with 
+ *  list_pop_front. The head of the list is then a stub node, producers append
+ *  with an atomic exchange of the tail and the consumer only follows the 
+ *  links published by the producers.
+ * 
+ *  Lists initialized with the LIST_TWO_LOCK flag also start with a stub node,
+ *  but the tail is protected by its own lock (two-lock queue). Producers only
+ *  take the tail lock and consumers only take the head lock, so both ends 
+ *  make progress at the same time. Methods that need the whole list take the
+ *  head lock first and then the tail lock.
+ * 
+ *  Lists initialized with the LIST_RWLOCK flag use a reader-writer lock 
+ *  instead of the mutex, so the methods that only read the list 
+ *  (list_get_by_index, list_print, list_for_each, list_for_each_reverse and
+ *  list_pool_info) run in parallel with each other. list_size doesn't take 
+ *  any lock, the number of elements is an atomic counter.
+ * 
+ *  Consumers can block until an element is available with list_pop_wait and
+ *  list_pop_front_wait. The waiting threads sleep on a condition variable 
+ *  that the push methods only signal when there is a thread waiting, and 
+ *  list_close wakes all of them up for a clean shutdown.
+ * 
+ *  A list can be bounded by setting a capacity in its configuration. When the
+ *  list is full list_push and list_push_front either wait for room or drop 
+ *  the element at the opposite end, depending on the overflow policy, while
+ *  list_try_push fails right away and list_push_wait waits with a timeout.
+ * 
+ *  list_splice moves all the nodes of a list to the end of another one, and 
+ *  list_take_all moves them to a new list, without copying the data. Both
+ *  lists are locked in order of address so that two threads splicing in 
+ *  opposite directions can't deadlock.
+ * 
+ *  Large elements can be read without copying them. list_peek_front and 
+ *  list_peek_at return a pointer to the data of a node and keep the list 
+ *  locked until list_peek_end is called, and list_pop_front_borrow detaches
+ *  the first node and hands its data to the caller, who gives it back with 
+ *  list_borrow_release.
+ * 
  *  ## Usage ##
  * 
  *  The Linked List implementation provides APIs to write and get elements from
@@ -55,41 +100,292 @@
 /******************************************************************************
 * Includes
 ******************************************************************************/
+#include <sched.h>              /* sched_yield */
+#include <time.h>               /* clock_gettime */
+#include <errno.h>              /* ETIMEDOUT */
+#include <stddef.h>             /* offsetof */
 #include "Linked_list.h"        /* Node and linked list structures typedefs*/
 
 /******************************************************************************
 * Module Preprocessor Constants
 ******************************************************************************/
+/**
+ * Mode flags of the lists whose head is a stub node
+ */
+#define LIST_STUB_MODES     (LIST_MPSC | LIST_TWO_LOCK)
+/**
+ * Mode flags that change the memory block of the nodes
+ */
+#define LIST_NODE_LAYOUT    (LIST_DOUBLY_LINKED | LIST_DWELL_TIME)
+/**
+ * Fewest elements given to each thread by the parallel methods. Shorter 
+ * lists use fewer threads, as starting the work costs more than it saves.
+ */
+#define LIST_PARALLEL_MIN_SEGMENT   1024
+/**
+ * Number of runs kept by list_sort, enough to merge 2^64 nodes
+ */
+#define LIST_SORT_BINS      64
+/**
+ * Bits of a dwell time kept by the histogram. Every power of two is split in
+ * 2^(DWELL_SUB_BITS - 1) buckets, so a bucket is at most 1/16 of its values
+ * wide.
+ */
+#define DWELL_SUB_BITS      5
+#define DWELL_SUB_BUCKETS   (1u << DWELL_SUB_BITS)
+#define DWELL_HALF_BUCKETS  (DWELL_SUB_BUCKETS / 2)
+/**
+ * Number of buckets of the dwell time histogram, enough for any 64 bit value
+ */
+#define DWELL_BUCKETS       (DWELL_SUB_BUCKETS + \
+                             (64 - DWELL_SUB_BITS) * DWELL_HALF_BUCKETS)
 
 
 /******************************************************************************
 * Module Preprocessor Macros
 ******************************************************************************/
+/**
+ * Offset of the node header inside the memory block of a node
+ */
+#define NODE_OFFSET(list)   ((((list)->flags & LIST_DOUBLY_LINKED) ? \
+                              sizeof(node_t *) : 0) + \
+                             (((list)->flags & LIST_DWELL_TIME) ? \
+                              sizeof(uint64_t) : 0))
+/**
+ * Pointer to the previous node, only valid in LIST_DOUBLY_LINKED lists
+ */
+#define NODE_PREV(node)     (((node_t **) (node))[-1])
+/**
+ * Creation time of the node, only valid in LIST_DWELL_TIME lists. It is 
+ * stored at the start of the memory block, before the previous node.
+ */
+#define NODE_STAMP(list, node) (*(uint64_t *) ((unsigned char *) (node) - \
+                                               NODE_OFFSET(list)))
+/**
+ * Pointer to the next node. In a list with a stub node the link may be 
+ * published by a producer at any time, so it is read with acquire semantics.
+ */
+#define NODE_NEXT(node)     __atomic_load_n(&(node)->next, __ATOMIC_ACQUIRE)
+/**
+ * Updates of the number of elements of a list without a stub node. They are
+ * always made with the lock taken, so a relaxed load and store are enough 
+ * and cheaper than an atomic read-modify-write, while list_size can still 
+ * read the count without the lock.
+ */
+#define COUNT_ADD(list, n)  atomic_store_explicit(&((list)->numElements), \
+                                atomic_load_explicit(&((list)->numElements), \
+                                                     memory_order_relaxed) + \
+                                (n), memory_order_relaxed)
+#define COUNT_SUB(list, n)  atomic_store_explicit(&((list)->numElements), \
+                                atomic_load_explicit(&((list)->numElements), \
+                                                     memory_order_relaxed) - \
+                                (n), memory_order_relaxed)
+/**
+ * Node that holds the given payload
+ */
+#define NODE_OF(data)       ((node_t *) ((unsigned char *) (data) - \
+                                         offsetof(node_t, data)))
+/**
+ * Whether a bounded list has no room for another element
+ */
+#define LIST_IS_FULL(list)  ((list)->capacity > 0 && \
+                             atomic_load(&((list)->numElements)) >= \
+                             (list)->capacity)
+/**
+ * Forgets the node cached by _list_node_at. It must be used by every method
+ * that removes nodes or inserts them before the end of the list, the index 
+ * of the cached node would no longer be right.
+ */
+#define FINGER_RESET(list)  ((list)->finger = NULL)
+/**
+ * Records the dwell time of a node that is popped from a LIST_DWELL_TIME 
+ * list
+ */
+#define DWELL_RECORD(list, node) (((list)->flags & LIST_DWELL_TIME) ? \
+                                  _list_dwell_record((list), (node)) : \
+                                  (void) 0)
+/**
+ * Updates of the statistics of the list. Without LIST_STATS they expand to
+ * nothing.
+ */
+#if LIST_STATS
+#define STATS_PUSHED(list, n)   _list_stats_pushed((list), (n))
+#define STATS_POPPED(list, n)   _list_stats_popped((list), (n))
+#define STATS_WATERMARK(list)   _list_stats_pushed((list), 0)
+#define STATS_LOCKED(list, contended, exclusive) \
+                                _list_stats_locked((list), (contended), \
+                                                   (exclusive))
+#define STATS_UNLOCKING(list)   _list_stats_unlocking(list)
+#else
+#define STATS_PUSHED(list, n)   ((void) 0)
+#define STATS_POPPED(list, n)   ((void) 0)
+#define STATS_WATERMARK(list)   ((void) 0)
+#define STATS_LOCKED(list, contended, exclusive) ((void) 0)
+#define STATS_UNLOCKING(list)   ((void) 0)
+#endif
+/**
+ * Takes a lock with lockFn. With LIST_STATS it is tried first with tryFn to 
+ * know whether it was contended.
+ */
+#if LIST_STATS
+#define LOCK_COUNTED(list, lock, lockFn, tryFn, exclusive) \
+    (((tryFn)(lock) == 0) ? STATS_LOCKED(list, 0, exclusive) : \
+                            ((void) (lockFn)(lock), \
+                             STATS_LOCKED(list, 1, exclusive)))
+#else
+#define LOCK_COUNTED(list, lock, lockFn, tryFn, exclusive) \
+    ((void) (lockFn)(lock))
+#endif
 
 
 /******************************************************************************
 * Module Typedefs
 ******************************************************************************/
+/*! @brief Node pool chunk structure definition
+ *
+ *  The nodes of the chunk are stored right after the header.
+ */
+struct list_chunk_t
+{
+    list_chunk_t* next;     /**< Pointer to the previously allocated chunk */
+    unsigned char nodes[];  /**< Nodes carved from the chunk */
+};
+
+/*! @brief Dwell time histogram structure definition
+ *
+ *  Log-linear histogram of the dwell times in ns. The values below 
+ *  DWELL_SUB_BUCKETS have a bucket each, the rest share a bucket with the 
+ *  values that have the same DWELL_SUB_BITS most significant bits. The 
+ *  buckets are updated with atomic increments, so the popping threads 
+ *  never take a lock to record a value.
+ */
+struct list_dwell_t
+{
+    atomic_uint_least64_t totalNs;  /**< Sum of the values recorded */
+    atomic_uint_least64_t maxNs;    /**< Largest value recorded */
+    atomic_uint_least64_t buckets[DWELL_BUCKETS]; /**< Values per bucket */
+};
+
+/*! @brief Parallel task structure definition
+ *
+ *  A task calls eachFn for count consecutive elements starting at first.
+ */
+struct list_task_t
+{
+    node_t* first;          /**< First node of the segment */
+    size_t count;           /**< Number of nodes of the segment */
+    void (*eachFn)(const void* data, void* arg); /**< Function called for 
+                                                       every element */
+    void* arg;              /**< Argument passed to eachFn */
+};
+
+/*! @brief Worker pool structure definition
+ *
+ *  The workers are created the first time they are needed and wait for the
+ *  tasks of the next parallel call afterwards. The pool runs the tasks of a 
+ *  single call at a time, the calling thread runs tasks too.
+ */
+struct list_workers_t
+{
+    pthread_mutex_t jobLock; /**< Mutex held during a whole parallel call */
+    pthread_mutex_t lock;   /**< Mutex protecting the rest of the fields */
+    pthread_cond_t wake;    /**< Condition signalled when there are tasks */
+    pthread_cond_t done;    /**< Condition signalled when the last task ends */
+    uint32_t numThreads;    /**< Number of workers created */
+    struct list_task_t* tasks; /**< Tasks of the current call */
+    size_t numTasks;        /**< Number of tasks of the current call */
+    size_t nextTask;        /**< Index of the next task to run */
+    size_t numPending;      /**< Tasks not finished yet */
+};
 
 
 /******************************************************************************
 * Module Variable Definitions
 ******************************************************************************/
-
+/**
+ * Worker pool shared by the parallel methods of every list
+ */
+static struct list_workers_t workers = {
+    .jobLock = PTHREAD_MUTEX_INITIALIZER,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+};
 
 /******************************************************************************
 * Function Prototypes
 ******************************************************************************/
-static node_t* create_node(size_t dataSize, const void* data);
-static void free_node(node_t* node);
+static node_t* create_node(list_t* list, const void* data);
+static void free_node(list_t* list, node_t* node);
+static node_t* pool_alloc_node(list_pool_t* pool, size_t nodeOffset);
+static void pool_free_chunks(list_pool_t* pool);
 static void _list_push(list_t* list, const void* data);
 static void _list_push_front(list_t* list, const void* data);
 static uint8_t _list_pop(list_t* list, void* data);
 static uint8_t _list_pop_front(list_t* list, void* data);
-static uint8_t _list_get_by_index(list_t* list, uint8_t index, void* data);
+static uint8_t _list_push_mpsc(list_t* list, const void* data);
+static uint8_t _list_push_two_lock(list_t* list, node_t* newNode);
+static uint8_t _list_push_front_stub(list_t* list, const void* data);
+static uint8_t _list_reserve(list_t* list);
+static size_t _list_reserve_n(list_t* list, size_t n);
+static node_t* _list_create_chain(list_t* list, const unsigned char* array, size_t n, node_t** last);
+static node_t* _list_split_chain(node_t* first, size_t count, node_t** last);
+static void _list_free_chain(list_t* list, node_t* first);
+static void _list_append_chain(list_t* list, node_t* first, node_t* last, size_t count);
+static size_t _list_pop_front_chain(list_t* list, unsigned char* out, size_t max, node_t** detached);
+static size_t _list_pop_front_chain_stub(list_t* list, unsigned char* out, size_t max, node_t** detached);
+static uint8_t _list_insert(list_t* list, const void* data, uint8_t front);
+static uint8_t _list_try_push_back(list_t* list, void* data);
+static uint8_t _list_try_push_front(list_t* list, void* data);
+static uint8_t _list_try_pop(list_t* list, void* data);
+static uint8_t _list_try_pop_front(list_t* list, void* data);
+static uint8_t _list_pop_stub(list_t* list, void* data);
+static uint8_t _list_pop_front_stub(list_t* list, void* data);
+static node_t* _list_first(list_t* list);
+static void _list_lock(list_t* list);
+static void _list_read_lock(list_t* list);
+static void _list_unlock(list_t* list);
+static void _list_lock_all(list_t* list);
+static void _list_unlock_all(list_t* list);
+static void _list_lock_pair(list_t* first, list_t* second);
+static void _list_unlock_pair(list_t* first, list_t* second);
+static node_t* _list_detach_all(list_t* list, size_t max, node_t** last, size_t* count);
+static void _list_attach_all(list_t* list, node_t* first, node_t* last, size_t count);
+static void _list_signal(list_t* list, atomic_size_t* numWaiters, pthread_cond_t* cond, size_t count);
+static uint8_t _list_block(list_t* list, uint8_t (*tryFn)(list_t* list, void* arg), void* arg, uint32_t timeoutMs, atomic_size_t* numWaiters, pthread_cond_t* cond);
+static uint8_t _list_wait(list_t* list, uint8_t (*tryFn)(list_t* list, void* arg), void* arg, uint32_t timeoutMs, uint8_t push);
+static node_t* _list_detach_front(list_t* list);
+static node_t* _list_detach_front_stub(list_t* list);
+static node_t* _list_detach_after_stub(list_t* list, node_t* prev);
+static node_t* _list_detach_after(list_t* list, node_t* prev);
+static node_t* _list_node_before(list_t* list, size_t index);
+static uint8_t _list_insert_at(list_t* list, size_t index, const void* data);
+static void _list_link_after(list_t* list, node_t* prev, node_t* newNode);
+static node_t* _list_merge_chains(node_t* first, node_t* second, int (*cmpFn)(const void* data, const void* key), node_t** last);
+static node_t* _list_sort_chain(node_t* first, int (*cmpFn)(const void* data, const void* key), node_t** last);
+static uint8_t _list_insert_sorted(list_t* list, int (*cmpFn)(const void* data, const void* key), const void* data);
+static node_t* _list_node_at(list_t* list, size_t index);
+static uint8_t _list_get_by_index(list_t* list, size_t index, void* data);
 static void _list_print(list_t* list, void (*printFn)(const void *data));
 static void _list_for_each(list_t* list, void (*eachFn)(const void* data, void* arg), void* arg);
-static uint8_t _list_size(list_t* list);
+static void _list_for_each_reverse(list_t* list, void (*eachFn)(const void* data, void* arg), void* arg);
+static size_t _list_partition(list_t* list, struct list_task_t* tasks, size_t numThreads);
+static void _list_run_task(struct list_task_t* task);
+static void* _list_worker(void* arg);
+static void _list_run_tasks(struct list_task_t* tasks, size_t numTasks);
+static size_t _list_size(list_t* list);
+static uint64_t _list_now_ns(void);
+static void _list_atomic_max(atomic_uint_least64_t* max, uint64_t value);
+static size_t _list_dwell_bucket(uint64_t ns);
+static uint64_t _list_dwell_bucket_max(size_t bucket);
+static void _list_dwell_record(list_t* list, node_t* node);
+static uint64_t _list_dwell_percentile(list_dwell_t* dwell, uint64_t count, uint32_t perMille);
+#if LIST_STATS
+static void _list_stats_pushed(list_t* list, size_t n);
+static void _list_stats_popped(list_t* list, size_t n);
+static void _list_stats_locked(list_t* list, uint8_t contended, uint8_t exclusive);
+static void _list_stats_unlocking(list_t* list);
+#endif
 
 /******************************************************************************
 * Function Definitions
@@ -113,30 +409,52 @@ static uint8_t _list_size(list_t* list);
  * 
  * \b Description:
  * 
- * This function is used to create and allocate memory for a new node. This 
+ * This function is used to create and allocate memory for a new node. The
+ * header and the data of the node are allocated as a single block. This 
  * function is private and it must only be used by internal methods.
  * 
- * @param value Value of the new node.
+ * @param list Linked list the node belongs to.
+ * @param data Pointer to the value of the new node. If it is NULL the data
+ *             of the node is left uninitialized.
  * 
  * @return A pointer to the new allocated node.
  * 
  * \b Example:
  * @code
  *      node_t* newNode = NULL;
- *      newNode = create_node(list->size, (void *) &data);
+ *      newNode = create_node(list, (void *) &data);
  * @endcode
  *
  */
 /*****************************************************************************/
 static node_t*
-create_node(size_t dataSize, const void* data)
+create_node(list_t* list, const void* data)
 {
     node_t* newNode = NULL;
+    size_t nodeOffset = NODE_OFFSET(list);
 
-    newNode = (node_t *) calloc(1, sizeof(struct node_t));
-    newNode->data = calloc(1, dataSize);
+    if (list->pool.nodesPerChunk > 0)
+      {
+          newNode = pool_alloc_node(&(list->pool), nodeOffset);
+      }
+    else
+      {
+          newNode = (node_t *) ((unsigned char *) malloc(nodeOffset + 
+                                                          sizeof(struct node_t) + 
+                                                          list->dataSize) + 
+                                nodeOffset);
+      }
     newNode->next = NULL;
-    memcpy(newNode->data, data, dataSize);
+
+    if (list->flags & LIST_DWELL_TIME)
+      {
+          NODE_STAMP(list, newNode) = _list_now_ns();
+      }
+
+    if (data != NULL)
+      {
+          memcpy(newNode->data, data, list->dataSize);
+      }
 
     return newNode;
 }
@@ -148,25 +466,120 @@ create_node(size_t dataSize, const void* data)
  * 
  * \b Description:
  * 
- * This function is used to free the memory of a node. This function is private 
- * and it must only be used by internal methods.
+ * This function is used to free the memory of a node. If the list uses a node
+ * pool the node is pushed to the free list of the pool instead. This function
+ * is private and it must only be used by internal methods.
  * 
+ * @param list Linked list the node belongs to.
  * @param node Node to free memory.
  * 
  * @return None.
  * 
  * \b Example:
  * @code
- *      free_node(node);
+ *      free_node(list, node);
  * @endcode
  *
  */
 /*****************************************************************************/
 static void 
-free_node(node_t* node)
+free_node(list_t* list, node_t* node)
+{
+    if (list->pool.nodesPerChunk > 0)
+      {
+          node->next = list->pool.freeNodes;
+          list->pool.freeNodes = node;
+      }
+    else
+      {
+          free((unsigned char *) node - NODE_OFFSET(list));
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to get a node from a node pool. Recycled nodes are 
+ * reused first, then nodes are carved from the newest chunk and a new chunk 
+ * is allocated only when the newest one is exhausted. This function is 
+ * private and it must only be used by internal methods.
+ * 
+ * @param pool Node pool.
+ * @param nodeOffset Offset of the node header inside its memory block.
+ * 
+ * @return A pointer to the node.
+ *
+ */
+/*****************************************************************************/
+static node_t*
+pool_alloc_node(list_pool_t* pool, size_t nodeOffset)
+{
+    node_t* node = NULL;
+    list_chunk_t* chunk = NULL;
+
+    if (pool->freeNodes != NULL)
+      {
+          node = pool->freeNodes;
+          pool->freeNodes = node->next;
+
+          return node;
+      }
+
+    if (pool->chunks == NULL || pool->numCarved == pool->nodesPerChunk)
+      {
+          chunk = (list_chunk_t *) malloc(sizeof(struct list_chunk_t) + 
+                                          pool->nodesPerChunk * pool->nodeSize);
+          chunk->next = pool->chunks;
+          pool->chunks = chunk;
+          pool->numChunks++;
+          pool->numCarved = 0;
+      }
+
+    node = (node_t *) (pool->chunks->nodes + pool->numCarved * pool->nodeSize + 
+                       nodeOffset);
+    pool->numCarved++;
+
+    return node;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to release every chunk of a node pool at once. The 
+ * nodes carved from the chunks must not be used afterwards. This function is 
+ * private and it must only be used by internal methods.
+ * 
+ * @param pool Node pool.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+pool_free_chunks(list_pool_t* pool)
 {
-    free(node->data);
-    free(node);
+    list_chunk_t* chunk = pool->chunks;
+    list_chunk_t* temp = NULL;
+
+    while (chunk != NULL)
+      {
+          temp = chunk->next;
+          free(chunk);
+          chunk = temp;
+      }
+
+    pool->chunks = NULL;
+    pool->freeNodes = NULL;
+    pool->numChunks = 0;
+    pool->numCarved = 0;
 }
 
 /*****************************************************************************/
@@ -192,15 +605,169 @@ free_node(node_t* node)
 void
 list_init(list_t* list, size_t dataSize)
 {
+    list_init_config(list, dataSize, NULL);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to intialize a linked list structure whose nodes are
+ * allocated from a node pool. Nodes are carved from chunks of nodesPerChunk
+ * nodes and popped nodes are reused by the following pushes, so once the 
+ * pool has grown to the working set no more allocations are done. The chunks
+ * are released by list_free() and list_destroy().
+ * 
+ * @param list Linked list to be initialized.
+ * @param dataSize Size of the data of the nodes.
+ * @param nodesPerChunk Number of nodes of each chunk of the pool. If it is 0
+ *                      the pool is disabled.
+ * 
+ * @return None.
+ * 
+ * \b Example:
+ * @code
+ *      list_t list;
+ *      list_init_pooled(&list, sizeof(uint32_t), 1024);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+list_init_pooled(list_t* list, size_t dataSize, size_t nodesPerChunk)
+{
+    list_config_t config = {0};
+
+    config.nodesPerChunk = nodesPerChunk;
+    list_init_config(list, dataSize, &config);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to intialize a linked list structure with a given
+ * configuration. The flags of the configuration select the mode of the list
+ * and nodesPerChunk enables the node pool (see list_init_pooled()).
+ * 
+ * @param list Linked list to be initialized.
+ * @param dataSize Size of the data of the nodes.
+ * @param config Configuration of the list. If it is NULL the default 
+ *               configuration is used.
+ * 
+ * @return 1 if the configuration is not valid and the list was not 
+ *         initialized, 0 otherwise.
+ * 
+ * \b Example:
+ * @code
+ *      list_t list;
+ *      list_config_t config = {0};
+ * 
+ *      config.flags = LIST_DOUBLY_LINKED;
+ *      list_init_config(&list, sizeof(uint32_t), &config);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+list_init_config(list_t* list, size_t dataSize, const list_config_t* config)
+{
+    size_t align = sizeof(node_t *);
+    pthread_condattr_t condAttr;
+
+    // Producers and consumers of a list with a stub node run concurrently, 
+    // they can't share a pool nor maintain back links
+    if (config != NULL && (config->flags & LIST_STUB_MODES) && 
+        ((config->flags & LIST_DOUBLY_LINKED) || config->nodesPerChunk > 0))
+      {
+          return 1;
+      }
+
+    if (config != NULL && 
+        (config->flags & LIST_STUB_MODES) == LIST_STUB_MODES)
+      {
+          return 1;
+      }
+
+    // Producers of a MPSC list can't pop the oldest element
+    if (config != NULL && (config->flags & LIST_MPSC) && 
+        config->capacity > 0 && 
+        config->overflowPolicy == LIST_OVERFLOW_DROP_OLDEST)
+      {
+          return 1;
+      }
+
     // Initialize the structure of the linked list
-    list->numElements = 0;
+    atomic_init(&(list->numElements), 0);
     list->dataSize = dataSize;
+    list->flags = (config != NULL) ? config->flags : 0;
+    list->capacity = (config != NULL) ? config->capacity : 0;
+    list->overflowPolicy = (config != NULL) ? config->overflowPolicy : 
+                                              LIST_OVERFLOW_BLOCK;
     list->head = NULL;
     list->tail = NULL;
+    list->finger = NULL;
+    list->fingerIndex = 0;
+    list->dwell = NULL;
+    memset(&(list->pool), 0, sizeof(list->pool));
+
+    if (list->flags & LIST_DWELL_TIME)
+      {
+          list->dwell = (list_dwell_t *) malloc(sizeof(list_dwell_t));
+          list_reset_dwell(list);
+      }
+
+    // Round the node size up so that every carved node is aligned
+    if (config != NULL && config->nodesPerChunk > 0)
+      {
+          list->pool.nodesPerChunk = config->nodesPerChunk;
+          list->pool.nodeSize = (NODE_OFFSET(list) + sizeof(struct node_t) + 
+                                 dataSize + align - 1) & ~(align - 1);
+      }
+
+    // The stub node is never removed, producers always have a tail to link to
+    if (list->flags & LIST_STUB_MODES)
+      {
+          list->head = create_node(list, NULL);
+          list->tail = list->head;
+      }
 
     // Initialize R/W mutex
     // It is used to avoid working with a busy linked list
-    pthread_mutex_init(&(list->lock), NULL);
+    if (list->flags & LIST_RWLOCK)
+      {
+          pthread_rwlock_init(&(list->rwlock), NULL);
+      }
+    else
+      {
+          pthread_mutex_init(&(list->lock), NULL);
+      }
+
+    if (list->flags & LIST_TWO_LOCK)
+      {
+          pthread_mutex_init(&(list->tailLock), NULL);
+      }
+
+    // Initialize the condition used to wait for elements
+    // The timeouts are measured with the monotonic clock
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    pthread_mutex_init(&(list->waitLock), NULL);
+    pthread_cond_init(&(list->notEmpty), &condAttr);
+    pthread_cond_init(&(list->notFull), &condAttr);
+    pthread_condattr_destroy(&condAttr);
+    atomic_init(&(list->numPopWaiters), 0);
+    atomic_init(&(list->numPushWaiters), 0);
+    atomic_init(&(list->closed), 0);
+
+#if LIST_STATS
+    list->stats.lockedAt = 0;
+    list_reset_stats(list);
+#endif
+
+    return 0;
 }
 
 /*****************************************************************************/
@@ -224,19 +791,38 @@ list_init(list_t* list, size_t dataSize)
 void
 list_free(list_t* list)
 {
-    node_t* iterator = list->head;
+    node_t* iterator = _list_first(list);
     node_t* temp = NULL;
 
+    FINGER_RESET(list);
+
+    // Pooled nodes are released with their chunks
+    if (list->pool.nodesPerChunk > 0)
+      {
+          pool_free_chunks(&(list->pool));
+          iterator = NULL;
+      }
+
     // Traverse the list and free every element
     while (iterator != NULL)
       {
           temp = iterator->next;
-          free_node(iterator);
+          free_node(list, iterator);
           iterator = temp;
       }
 
-    list->head = NULL;
-    list->tail = NULL;
+    // Keep the stub node, it is released by list_destroy
+    if (list->flags & LIST_STUB_MODES)
+      {
+          list->head->next = NULL;
+          list->tail = list->head;
+      }
+    else
+      {
+          list->head = NULL;
+          list->tail = NULL;
+      }
+
     list->numElements = 0;
 }
 
@@ -263,7 +849,34 @@ void
 list_destroy(list_t* list)
 {
     list_free(list);
-    pthread_mutex_destroy(&(list->lock));
+
+    if (list->flags & LIST_STUB_MODES)
+      {
+          free_node(list, list->head);
+          list->head = NULL;
+          list->tail = NULL;
+      }
+
+    if (list->flags & LIST_RWLOCK)
+      {
+          pthread_rwlock_destroy(&(list->rwlock));
+      }
+    else
+      {
+          pthread_mutex_destroy(&(list->lock));
+      }
+
+    if (list->flags & LIST_TWO_LOCK)
+      {
+          pthread_mutex_destroy(&(list->tailLock));
+      }
+
+    pthread_cond_destroy(&(list->notEmpty));
+    pthread_cond_destroy(&(list->notFull));
+    pthread_mutex_destroy(&(list->waitLock));
+
+    free(list->dwell);
+    list->dwell = NULL;
 }
 
 /*****************************************************************************/
@@ -287,7 +900,12 @@ static void
 _list_push(list_t* list, const void* data)
 {
     node_t* newNode = NULL;
-    newNode = create_node(list->dataSize, data);
+    newNode = create_node(list, data);
+
+    if (list->flags & LIST_DOUBLY_LINKED)
+      {
+          NODE_PREV(newNode) = list->tail;
+      }
 
     if (list->numElements == 0)
       { 
@@ -300,7 +918,7 @@ _list_push(list_t* list, const void* data)
           list->tail = newNode; 
       }
     
-    list->numElements++;
+    COUNT_ADD(list, 1);
 }
 
 /*****************************************************************************/
@@ -308,7 +926,10 @@ _list_push(list_t* list, const void* data)
  * 
  * \b Description:
  * 
- * This function is used to add a node to the end of the list.
+ * This function is used to add a node to the end of the list. If the list is
+ * bounded and full, it waits for room or drops the oldest element depending
+ * on the overflow policy. If the list is closed while waiting the element is
+ * discarded.
  * 
  * @param list Linked list.
  * @param data Pointer to the variable which value will be inserted at the end 
@@ -326,9 +947,8 @@ _list_push(list_t* list, const void* data)
 void 
 list_push(list_t* list, const void* data)
 {
-    pthread_mutex_lock(&(list->lock));
-        _list_push(list, data);
-    pthread_mutex_unlock(&(list->lock));
+    // Only a full list with the blocking overflow policy fails to insert
+    _list_wait(list, _list_try_push_back, (void *) data, LIST_WAIT_FOREVER, 1);
 }
 
 /*****************************************************************************/
@@ -353,9 +973,21 @@ _list_push_front(list_t* list, const void* data)
 {
     node_t* newNode = NULL;
 
-    newNode = create_node(list->dataSize, data);
+    FINGER_RESET(list);
+
+    newNode = create_node(list, data);
     newNode->next = list->head;
 
+    if (list->flags & LIST_DOUBLY_LINKED)
+      {
+          NODE_PREV(newNode) = NULL;
+
+          if (list->head != NULL)
+            {
+                NODE_PREV(list->head) = newNode;
+            }
+      }
+
     if (list->numElements == 0)
       {
           list->tail = newNode; 
@@ -364,7 +996,7 @@ _list_push_front(list_t* list, const void* data)
     // Insert new node to the front of the list
     list->head = newNode; 
 
-    list->numElements++;
+    COUNT_ADD(list, 1);
 }
 
 /*****************************************************************************/
@@ -372,7 +1004,10 @@ _list_push_front(list_t* list, const void* data)
  * 
  * \b Description:
  * 
- * This function is used to add a node to the front of the list.
+ * This function is used to add a node to the front of the list. If the list 
+ * is bounded and full, it waits for room or drops the element at the end of
+ * the list depending on the overflow policy. If the list is closed while 
+ * waiting the element is discarded.
  * 
  * @param list Linked list.
  * @param data Pointer to the variable which value will be inserted at the 
@@ -390,9 +1025,8 @@ _list_push_front(list_t* list, const void* data)
 void
 list_push_front(list_t* list, const void* data)
 {
-    pthread_mutex_lock(&(list->lock));
-        _list_push_front(list, data);
-    pthread_mutex_unlock(&(list->lock));
+    // Only a full list with the blocking overflow policy fails to insert
+    _list_wait(list, _list_try_push_front, (void *) data, LIST_WAIT_FOREVER, 1);
 }
 
 /*****************************************************************************/
@@ -402,203 +1036,4437 @@ list_push_front(list_t* list, const void* data)
  * 
  * \b Description:
  * 
- * This function is used to get the node at the end of the list.
+ * This function is used to insert a node at one end of the list, applying 
+ * the overflow policy if the list is bounded and full. The threads waiting 
+ * for elements are not woken up, it is left to the caller.
  * 
  * @param list Linked list.
- * @param data Pointer to the variable to which will be copied the value of the
- *             node at the end of the list.
- * 
- * @return 1 if there are no elements, 0 otherwise.
+ * @param data Pointer to the variable which value will be inserted.
+ * @param front 1 to insert at the front of the list, 0 at the end.
  * 
+ * @return 1 if the list is full, 0 otherwise.
+ *
  */
 /*****************************************************************************/
 static uint8_t
-_list_pop(list_t* list, void* data)
+_list_insert(list_t* list, const void* data, uint8_t front)
 {
-    node_t* iterator = list->head;
+    node_t* newNode = NULL;
+    uint8_t dropOldest = (list->overflowPolicy == LIST_OVERFLOW_DROP_OLDEST);
+    uint8_t retval = 0;
 
-    // If the linked list is empty, return error
-    if (list->numElements == 0)
+    if (front)
       {
-          return 1;
+          _list_lock_all(list);
+              // The element at the end of the list makes room for the new one
+              if (dropOldest && LIST_IS_FULL(list))
+                {
+                    if (list->flags & LIST_STUB_MODES)
+                      {
+                          _list_pop_stub(list, NULL);
+                      }
+                    else
+                      {
+                          _list_pop(list, NULL);
+                      }
+                }
+
+              if (list->flags & LIST_STUB_MODES)
+                {
+                    retval = _list_push_front_stub(list, data);
+                }
+              else if (LIST_IS_FULL(list))
+                {
+                    retval = 1;
+                }
+              else
+                {
+                    _list_push_front(list, data);
+                }
+          _list_unlock_all(list);
       }
-    // If there is only one item in the list, remove it
-    else if (list->numElements == 1)
+    else if (list->flags & LIST_MPSC)
       {
-          memcpy(data, list->head->data, list->dataSize);
-          free_node(list->head);
-          list->head = NULL;
-          list->tail = NULL;
-          list->numElements--;
-          
-          return 0;
+          // Producers of a MPSC list don't take the lock
+          retval = _list_push_mpsc(list, data);
       }
+    else if (list->flags & LIST_TWO_LOCK)
+      {
+          // Producers of a two-lock list only take the tail lock
+          newNode = create_node(list, data);
 
-    // Get the penultimate node
-    // The penultimate node is required to make it's next variable NULL
-    while (iterator->next->next != NULL)
+          pthread_mutex_lock(&(list->tailLock));
+              retval = _list_push_two_lock(list, newNode);
+          pthread_mutex_unlock(&(list->tailLock));
+
+          // Dropping the oldest element needs the head lock too, which must
+          // be taken before the tail lock
+          if (retval != 0 && dropOldest)
+            {
+                _list_lock_all(list);
+                    if (LIST_IS_FULL(list))
+                      {
+                          _list_pop_front_stub(list, NULL);
+                      }
+                    retval = _list_push_two_lock(list, newNode);
+                _list_unlock_all(list);
+            }
+
+          if (retval != 0)
+            {
+                free_node(list, newNode);
+            }
+      }
+    else
       {
-          iterator = iterator->next;
+          _list_lock(list);
+              // The oldest element makes room for the new one
+              if (dropOldest && LIST_IS_FULL(list))
+                {
+                    _list_pop_front(list, NULL);
+                }
+
+              if (LIST_IS_FULL(list))
+                {
+                    retval = 1;
+                }
+              else
+                {
+                    _list_push(list, data);
+                }
+          _list_unlock(list);
       }
 
-    // Get the last node and delete it
-    memcpy(data, iterator->next->data, list->dataSize);
-    free_node(iterator->next);
+    if (retval == 0)
+      {
+          STATS_PUSHED(list, 1);
+      }
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to try to add a node to the end of the list. It has
+ * the signature expected by _list_wait.
+ * 
+ * @param list Linked list.
+ * @param data Pointer to the variable which value will be inserted at the end 
+ *             of the list.
+ * 
+ * @return 1 if the list is full, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_list_try_push_back(list_t* list, void* data)
+{
+    return _list_insert(list, data, 0);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to try to add a node to the front of the list. It 
+ * has the signature expected by _list_wait.
+ * 
+ * @param list Linked list.
+ * @param data Pointer to the variable which value will be inserted at the 
+ *             front of the list.
+ * 
+ * @return 1 if the list is full, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_list_try_push_front(list_t* list, void* data)
+{
+    return _list_insert(list, data, 1);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to add a node to the end of the list without waiting
+ * if the list is full. With the LIST_OVERFLOW_DROP_OLDEST policy the oldest
+ * element is dropped instead, so it never fails.
+ * 
+ * @param list Linked list.
+ * @param data Pointer to the variable which value will be inserted at the end 
+ *             of the list.
+ * 
+ * @return 1 if the list is full, 0 otherwise.
+ * 
+ * \b Example:
+ * @code
+ *      uint8_t error = list_try_push(&list, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+list_try_push(list_t* list, const void* data)
+{
+    uint8_t retval = _list_insert(list, data, 0);
+
+    if (retval == 0)
+      {
+          _list_signal(list, &(list->numPopWaiters), &(list->notEmpty), 1);
+      }
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to add a node to the end of the list, waiting for 
+ * room if the list is full.
+ * 
+ * @param list Linked list.
+ * @param data Pointer to the variable which value will be inserted at the end 
+ *             of the list.
+ * @param timeoutMs Maximum time to wait in milliseconds, LIST_WAIT_FOREVER to
+ *                  wait without limit.
+ * 
+ * @return 0 if the element was pushed, 1 if the timeout expired, 2 if the 
+ *         list is closed and full.
+ * 
+ * \b Example:
+ * @code
+ *      uint8_t error = list_push_wait(&list, (void *) &data, 100);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+list_push_wait(list_t* list, const void* data, uint32_t timeoutMs)
+{
+    return _list_wait(list, _list_try_push_back, (void *) data, timeoutMs, 1);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to create a chain of nodes from the elements of an 
+ * array. The nodes are linked in the order of the array, and also backwards 
+ * if the list is doubly linked. If the list uses a node pool it must be 
+ * called with the lock taken.
+ * 
+ * @param list Linked list the nodes belong to.
+ * @param array Pointer to the elements to insert, stored contiguously.
+ * @param n Number of elements in the array.
+ * @param last Pointer to the variable to which will be copied the last node 
+ *             of the chain.
+ * 
+ * @return First node of the chain, NULL if n is 0.
+ *
+ */
+/*****************************************************************************/
+static node_t*
+_list_create_chain(list_t* list, 
+                   const unsigned char* array, 
+                   size_t n, 
+                   node_t** last)
+{
+    node_t* first = NULL;
+    node_t* newNode = NULL;
+    size_t i;
+
+    *last = NULL;
+
+    for (i = 0; i < n; i++)
+      {
+          newNode = create_node(list, array + i * list->dataSize);
+
+          if (list->flags & LIST_DOUBLY_LINKED)
+            {
+                NODE_PREV(newNode) = *last;
+            }
+
+          if (first == NULL)
+            {
+                first = newNode;
+            }
+          else
+            {
+                (*last)->next = newNode;
+            }
+          *last = newNode;
+      }
+
+    return first;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to split a chain of nodes after its first count 
+ * nodes.
+ * 
+ * @param first First node of the chain.
+ * @param count Number of nodes to keep in the chain.
+ * @param last Pointer to the variable to which will be copied the last node 
+ *             kept in the chain, NULL if count is 0.
+ * 
+ * @return First node of the rest of the chain, NULL if there are no more
+ *         nodes.
+ *
+ */
+/*****************************************************************************/
+static node_t*
+_list_split_chain(node_t* first, size_t count, node_t** last)
+{
+    node_t* rest = NULL;
+    size_t i;
+
+    if (count == 0)
+      {
+          *last = NULL;
+          return first;
+      }
+
+    *last = first;
+    for (i = 1; i < count; i++)
+      {
+          *last = (*last)->next;
+      }
+
+    rest = (*last)->next;
+    (*last)->next = NULL;
+
+    return rest;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to free a chain of nodes. If the list uses a node 
+ * pool it must be called with the lock taken.
+ * 
+ * @param list Linked list the nodes belong to.
+ * @param first First node of the chain.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_free_chain(list_t* list, node_t* first)
+{
+    node_t* temp = NULL;
+
+    while (first != NULL)
+      {
+          temp = first;
+          first = first->next;
+          free_node(list, temp);
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to add a chain of nodes to the end of the list.
+ * 
+ * @param list Linked list.
+ * @param first First node of the chain.
+ * @param last Last node of the chain.
+ * @param count Number of nodes in the chain.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_append_chain(list_t* list, node_t* first, node_t* last, size_t count)
+{
+    if (list->flags & LIST_DOUBLY_LINKED)
+      {
+          NODE_PREV(first) = list->tail;
+      }
+
+    if (list->numElements == 0)
+      {
+          list->head = first;
+      }
+    else
+      {
+          list->tail->next = first;
+      }
+    list->tail = last;
+
+    COUNT_ADD(list, count);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to add n nodes to the end of the list taking the 
+ * lock only once. The nodes are created before the lock is taken unless the
+ * list uses a node pool. A bounded list only takes the elements that fit, 
+ * unless its overflow policy is LIST_OVERFLOW_DROP_OLDEST, in which case the
+ * oldest elements are dropped to make room for the last ones of the array.
+ * This function never waits.
+ * 
+ * @param list Linked list.
+ * @param array Pointer to the elements to insert, stored contiguously.
+ * @param n Number of elements in the array.
+ * 
+ * @return Number of elements pushed.
+ * 
+ * \b Example:
+ * @code
+ *      uint32_t data[16];
+ *      size_t count = list_push_n(&list, (void *) data, 16);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+size_t
+list_push_n(list_t* list, const void* array, size_t n)
+{
+    const unsigned char* elements = (const unsigned char *) array;
+    uint8_t dropOldest = (list->capacity > 0 && 
+                          list->overflowPolicy == LIST_OVERFLOW_DROP_OLDEST);
+    node_t* first = NULL;
+    node_t* last = NULL;
+    node_t* prev = NULL;
+    node_t* rest = NULL;
+    size_t count = 0;
+
+    // Only the last elements of the array fit when dropping the oldest ones
+    if (dropOldest && n > list->capacity)
+      {
+          elements += (n - list->capacity) * list->dataSize;
+          n = list->capacity;
+      }
+
+    if (n == 0)
+      {
+          return 0;
+      }
+
+    if (list->flags & LIST_MPSC)
+      {
+          // The whole chain is published with a single exchange of the tail
+          count = _list_reserve_n(list, n);
+          if (count > 0)
+            {
+                first = _list_create_chain(list, elements, count, &last);
+                prev = __atomic_exchange_n(&(list->tail), last, 
+                                           __ATOMIC_ACQ_REL);
+                __atomic_store_n(&(prev->next), first, __ATOMIC_RELEASE);
+            }
+      }
+    else if (list->flags & LIST_TWO_LOCK)
+      {
+          first = _list_create_chain(list, elements, n, &last);
+
+          if (dropOldest)
+            {
+                // Dropping the oldest elements needs the head lock too
+                _list_lock_all(list);
+                    while (list->numElements + n > list->capacity)
+                      {
+                          _list_pop_front_stub(list, NULL);
+                      }
+                    count = _list_reserve_n(list, n);
+                    __atomic_store_n(&(list->tail->next), first, 
+                                     __ATOMIC_RELEASE);
+                    list->tail = last;
+                _list_unlock_all(list);
+            }
+          else
+            {
+                pthread_mutex_lock(&(list->tailLock));
+                    count = _list_reserve_n(list, n);
+                    rest = _list_split_chain(first, count, &last);
+                    if (count > 0)
+                      {
+                          __atomic_store_n(&(list->tail->next), first, 
+                                           __ATOMIC_RELEASE);
+                          list->tail = last;
+                      }
+                pthread_mutex_unlock(&(list->tailLock));
+            }
+      }
+    else
+      {
+          // Nodes from the pool can only be taken with the lock
+          if (list->pool.nodesPerChunk == 0)
+            {
+                first = _list_create_chain(list, elements, n, &last);
+            }
+
+          _list_lock(list);
+              while (dropOldest && list->numElements + n > list->capacity)
+                {
+                    _list_pop_front(list, NULL);
+                }
+
+              count = n;
+              if (list->capacity > 0 && 
+                  list->numElements + count > list->capacity)
+                {
+                    count = list->capacity - list->numElements;
+                }
+
+              if (list->pool.nodesPerChunk > 0)
+                {
+                    first = _list_create_chain(list, elements, count, &last);
+                }
+              else
+                {
+                    rest = _list_split_chain(first, count, &last);
+                }
+
+              if (count > 0)
+                {
+                    _list_append_chain(list, first, last, count);
+                }
+          _list_unlock(list);
+      }
+
+    // The nodes that didn't fit are freed out of the critical section
+    _list_free_chain(list, rest);
+
+    if (count > 0)
+      {
+          STATS_PUSHED(list, count);
+          _list_signal(list, &(list->numPopWaiters), &(list->notEmpty), count);
+      }
+
+    return count;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the node at the end of the list.
+ * 
+ * @param list Linked list.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             node at the end of the list. If it is NULL the value is 
+ *             discarded.
+ * 
+ * @return 1 if there are no elements, 0 otherwise.
+ * 
+ */
+/*****************************************************************************/
+static uint8_t
+_list_pop(list_t* list, void* data)
+{
+    node_t* iterator = list->head;
+
+    FINGER_RESET(list);
+
+    // If the linked list is empty, return error
+    if (list->numElements == 0)
+      {
+          return 1;
+      }
+    // If there is only one item in the list, remove it
+    else if (list->numElements == 1)
+      {
+          if (data != NULL)
+            {
+                memcpy(data, list->head->data, list->dataSize);
+            }
+          DWELL_RECORD(list, list->head);
+          free_node(list, list->head);
+          list->head = NULL;
+          list->tail = NULL;
+          COUNT_SUB(list, 1);
+          
+          return 0;
+      }
+
+    // The previous node of the tail is known, no need to walk the list
+    if (list->flags & LIST_DOUBLY_LINKED)
+      {
+          iterator = list->tail;
+          if (data != NULL)
+            {
+                memcpy(data, iterator->data, list->dataSize);
+            }
+          list->tail = NODE_PREV(iterator);
+          list->tail->next = NULL;
+          DWELL_RECORD(list, iterator);
+          free_node(list, iterator);
+          COUNT_SUB(list, 1);
+
+          return 0;
+      }
+
+    // Get the penultimate node
+    // The penultimate node is required to make it's next variable NULL
+    while (iterator->next->next != NULL)
+      {
+          iterator = iterator->next;
+      }
+
+    // Get the last node and delete it
+    if (data != NULL)
+      {
+          memcpy(data, iterator->next->data, list->dataSize);
+      }
+    DWELL_RECORD(list, iterator->next);
+    free_node(list, iterator->next);
     iterator->next = NULL;
+    COUNT_SUB(list, 1);
+    list->tail = iterator;
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to try to get the node at the end of the list. The
+ * threads waiting for room are not woken up, so it can be called by 
+ * _list_wait with the wait lock taken.
+ * 
+ * @param list Linked list.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             node at the end of the list.
+ * 
+ * @return 1 if there are no elements, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_list_try_pop(list_t* list, void* data)
+{
+    uint8_t retval;
+
+    _list_lock_all(list);
+        if (list->flags & LIST_STUB_MODES)
+          {
+              retval = _list_pop_stub(list, data);
+          }
+        else
+          {
+              retval = _list_pop(list, data);
+          }
+    _list_unlock_all(list);
+
+    STATS_POPPED(list, (retval == 0) ? 1 : 0);
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the node at the end of the list.
+ * 
+ * @param list Linked list.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             node at the end of the list.
+ * 
+ * @return 1 if there are no elements, 0 otherwise.
+ * 
+ * \b Example:
+ * @code
+ *      uint8_t error = list_pop(&list, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t 
+list_pop(list_t* list, void* data)
+{
+    uint8_t retval = _list_try_pop(list, data);
+
+    if (retval == 0 && list->capacity > 0)
+      {
+          _list_signal(list, &(list->numPushWaiters), &(list->notFull), 1);
+      }
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the node at the front of the list.
+ * 
+ * @param list Linked list.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             node at the front of the list. If it is NULL the value is 
+ *             discarded.
+ * 
+ * @return 1 if there are no elements, 0 otherwise.
+ * 
+ */
+/*****************************************************************************/
+static uint8_t
+_list_pop_front(list_t* list, void* data)
+{
+    node_t* temp;
+
+    FINGER_RESET(list);
+
+    // If the linked list is empty, return error
+    if (list->numElements == 0)
+      {
+          return 1;
+      }
+    else if (list->numElements == 1)
+      {
+          if (data != NULL)
+            {
+                memcpy(data, list->head->data, list->dataSize);
+            }
+          DWELL_RECORD(list, list->head);
+          free_node(list, list->head);
+          list->head = NULL;
+          list->tail = NULL;
+          COUNT_SUB(list, 1);
+
+          return 0;
+      }
+
+    if (data != NULL)
+      {
+          memcpy(data, list->head->data, list->dataSize);
+      }
+    temp = list->head;
+    list->head = list->head->next;
+    DWELL_RECORD(list, temp);
+    free_node(list, temp);
+
+    if (list->flags & LIST_DOUBLY_LINKED)
+      {
+          NODE_PREV(list->head) = NULL;
+      }
+
+    COUNT_SUB(list, 1);
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to unlink the node at the front of the list without
+ * freeing it.
+ * 
+ * @param list Linked list.
+ * 
+ * @return Node unlinked, NULL if the list is empty.
+ *
+ */
+/*****************************************************************************/
+static node_t*
+_list_detach_front(list_t* list)
+{
+    node_t* first = list->head;
+
+    FINGER_RESET(list);
+
+    if (first == NULL)
+      {
+          return NULL;
+      }
+
+    list->head = first->next;
+    if (list->head == NULL)
+      {
+          list->tail = NULL;
+      }
+    else if (list->flags & LIST_DOUBLY_LINKED)
+      {
+          NODE_PREV(list->head) = NULL;
+      }
+    COUNT_SUB(list, 1);
+
+    first->next = NULL;
+    return first;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to unlink the first node after the stub without 
+ * freeing it. Unlike _list_pop_front_stub the stub is kept. It must be 
+ * called with the head lock taken.
+ * 
+ * @param list Linked list.
+ * 
+ * @return Node unlinked, NULL if the list is empty.
+ *
+ */
+/*****************************************************************************/
+static node_t*
+_list_detach_front_stub(list_t* list)
+{
+    FINGER_RESET(list);
+
+    return _list_detach_after_stub(list, list->head);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to unlink the node that follows a given node of a 
+ * list with a stub node without freeing it. If the node is the last one the
+ * tail has to be moved back to the previous node, under the tail lock in a 
+ * LIST_TWO_LOCK list or with a compare and swap in a LIST_MPSC list. It must
+ * be called with the head lock taken.
+ * 
+ * @param list Linked list.
+ * @param prev Node before the one to unlink, the stub or a linked node.
+ * 
+ * @return Node unlinked, NULL if prev is the last node.
+ *
+ */
+/*****************************************************************************/
+static node_t*
+_list_detach_after_stub(list_t* list, node_t* prev)
+{
+    node_t* first = NODE_NEXT(prev);
+    node_t* next = NULL;
+    node_t* expected = NULL;
+
+    // Empty, or the producer of the node didn't link it yet
+    if (first == NULL)
+      {
+          return NULL;
+      }
+
+    for (;;)
+      {
+          next = NODE_NEXT(first);
+          if (next != NULL)
+            {
+                // The producers don't touch a node that isn't the tail
+                __atomic_store_n(&(prev->next), next, __ATOMIC_RELAXED);
+                break;
+            }
+
+          if (list->flags & LIST_TWO_LOCK)
+            {
+                pthread_mutex_lock(&(list->tailLock));
+                    if (list->tail == first)
+                      {
+                          prev->next = NULL;
+                          list->tail = prev;
+                          next = first;
+                      }
+                pthread_mutex_unlock(&(list->tailLock));
+
+                if (next != NULL)
+                  {
+                      break;
+                  }
+            }
+          else
+            {
+                // The link is cleared first because the next producer 
+                // links its node to prev as soon as the swap succeeds
+                __atomic_store_n(&(prev->next), NULL, __ATOMIC_RELAXED);
+                expected = first;
+                if (__atomic_compare_exchange_n(&(list->tail), &expected, prev,
+                                                0, __ATOMIC_ACQ_REL, 
+                                                __ATOMIC_ACQUIRE))
+                  {
+                      break;
+                  }
+
+                // A producer swapped the tail but didn't link its node yet
+                __atomic_store_n(&(prev->next), first, __ATOMIC_RELAXED);
+                sched_yield();
+            }
+      }
+
+    list->numElements--;
+
+    first->next = NULL;
+    return first;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the node at the front of the list without 
+ * copying its value. The node is unlinked from the list and its value is 
+ * handed to the caller, who must give it back with list_borrow_release.
+ * 
+ * @param list Linked list.
+ * 
+ * @return Pointer to the value of the node, NULL if the list is empty.
+ * 
+ * \b Example:
+ * @code
+ *      record_t* record = list_pop_front_borrow(&list);
+ *      if (record != NULL)
+ *        {
+ *            process(record);
+ *            list_borrow_release(&list, record);
+ *        }
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void*
+list_pop_front_borrow(list_t* list)
+{
+    node_t* node;
+
+    _list_lock(list);
+        if (list->flags & LIST_STUB_MODES)
+          {
+              node = _list_detach_front_stub(list);
+          }
+        else
+          {
+              node = _list_detach_front(list);
+          }
+    _list_unlock(list);
+
+    STATS_POPPED(list, (node != NULL) ? 1 : 0);
+
+    if (node == NULL)
+      {
+          return NULL;
+      }
+
+    DWELL_RECORD(list, node);
+
+    if (list->capacity > 0)
+      {
+          _list_signal(list, &(list->numPushWaiters), &(list->notFull), 1);
+      }
+
+    return node->data;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to free the node of a value returned by 
+ * list_pop_front_borrow. The value must not be used afterwards.
+ * 
+ * @param list Linked list the value was popped from.
+ * @param data Pointer returned by list_pop_front_borrow.
+ * 
+ * @return None.
+ * 
+ * \b Example:
+ * @code
+ *      list_borrow_release(&list, record);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+list_borrow_release(list_t* list, void* data)
+{
+    // Nodes from the pool can only be returned with the lock
+    if (list->pool.nodesPerChunk > 0)
+      {
+          _list_lock(list);
+              free_node(list, NODE_OF(data));
+          _list_unlock(list);
+      }
+    else
+      {
+          free_node(list, NODE_OF(data));
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to detach up to max nodes from the front of the 
+ * list, copying their values to an array.
+ * 
+ * @param list Linked list.
+ * @param out Pointer to the array to which will be copied the values.
+ * @param max Maximum number of nodes to detach.
+ * @param detached Pointer to the variable to which will be copied the chain
+ *                 of detached nodes, to be freed by the caller.
+ * 
+ * @return Number of nodes detached.
+ *
+ */
+/*****************************************************************************/
+static size_t
+_list_pop_front_chain(list_t* list, 
+                      unsigned char* out, 
+                      size_t max, 
+                      node_t** detached)
+{
+    node_t* iterator = list->head;
+    node_t* last = NULL;
+    size_t count = 0;
+
+    FINGER_RESET(list);
+
+    while (count < max && iterator != NULL)
+      {
+          memcpy(out + count * list->dataSize, iterator->data, list->dataSize);
+          DWELL_RECORD(list, iterator);
+          last = iterator;
+          iterator = iterator->next;
+          count++;
+      }
+
+    if (count == 0)
+      {
+          *detached = NULL;
+          return 0;
+      }
+
+    *detached = list->head;
+    last->next = NULL;
+
+    list->head = iterator;
+    if (iterator == NULL)
+      {
+          list->tail = NULL;
+      }
+    else if (list->flags & LIST_DOUBLY_LINKED)
+      {
+          NODE_PREV(iterator) = NULL;
+      }
+    COUNT_SUB(list, count);
+
+    return count;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to detach up to max nodes from the front of a list 
+ * with a stub node, copying their values to an array. The last node copied 
+ * becomes the new stub, so the detached chain starts with the old stub.
+ * 
+ * @param list Linked list.
+ * @param out Pointer to the array to which will be copied the values.
+ * @param max Maximum number of nodes to detach.
+ * @param detached Pointer to the variable to which will be copied the chain
+ *                 of detached nodes, to be freed by the caller.
+ * 
+ * @return Number of nodes detached.
+ *
+ */
+/*****************************************************************************/
+static size_t
+_list_pop_front_chain_stub(list_t* list, 
+                           unsigned char* out, 
+                           size_t max, 
+                           node_t** detached)
+{
+    node_t* stub = list->head;
+    node_t* last = stub;
+    node_t* next = NULL;
+    size_t count = 0;
+
+    FINGER_RESET(list);
+
+    // Stop at the first node a producer didn't link yet
+    while (count < max && (next = NODE_NEXT(last)) != NULL)
+      {
+          memcpy(out + count * list->dataSize, next->data, list->dataSize);
+          DWELL_RECORD(list, next);
+          last = next;
+          count++;
+      }
+
+    if (count == 0)
+      {
+          *detached = NULL;
+          return 0;
+      }
+
+    // Producers may still link to the new stub, so only the nodes before it
+    // are detached
+    *detached = stub;
+    _list_split_chain(stub, count, &next);
+    list->head = last;
+    list->numElements -= count;
+
+    return count;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to get up to max nodes from the front of the list 
+ * taking the lock only once. The values are copied contiguously to the 
+ * output array and the nodes are freed after releasing the lock, unless the
+ * list uses a node pool.
+ * 
+ * @param list Linked list.
+ * @param out Pointer to the array to which will be copied the values of the
+ *            nodes, with room for max elements.
+ * @param max Maximum number of nodes to get.
+ * 
+ * @return Number of nodes popped, 0 if the list is empty.
+ * 
+ * \b Example:
+ * @code
+ *      uint32_t data[16];
+ *      size_t count = list_pop_front_n(&list, (void *) data, 16);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+size_t
+list_pop_front_n(list_t* list, void* out, size_t max)
+{
+    node_t* detached = NULL;
+    size_t count;
+
+    _list_lock(list);
+        if (list->flags & LIST_STUB_MODES)
+          {
+              count = _list_pop_front_chain_stub(list, (unsigned char *) out, 
+                                                 max, &detached);
+          }
+        else
+          {
+              count = _list_pop_front_chain(list, (unsigned char *) out, max,
+                                            &detached);
+          }
+
+        // Nodes from the pool can only be returned with the lock
+        if (list->pool.nodesPerChunk > 0)
+          {
+              _list_free_chain(list, detached);
+              detached = NULL;
+          }
+    _list_unlock(list);
+
+    _list_free_chain(list, detached);
+
+    STATS_POPPED(list, count);
+
+    if (count > 0 && list->capacity > 0)
+      {
+          _list_signal(list, &(list->numPushWaiters), &(list->notFull), count);
+      }
+
+    return count;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to take the locks of two lists, always in order of
+ * address to avoid deadlocks.
+ * 
+ * @param first Linked list.
+ * @param second Linked list.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_lock_pair(list_t* first, list_t* second)
+{
+    if ((uintptr_t) first < (uintptr_t) second)
+      {
+          _list_lock_all(first);
+          _list_lock_all(second);
+      }
+    else
+      {
+          _list_lock_all(second);
+          _list_lock_all(first);
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to release the locks taken by _list_lock_pair.
+ * 
+ * @param first Linked list.
+ * @param second Linked list.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_unlock_pair(list_t* first, list_t* second)
+{
+    _list_unlock_all(first);
+    _list_unlock_all(second);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to detach all the nodes of the list, leaving it 
+ * empty. It must be called with all the locks of the list taken. The 
+ * producers of a LIST_MPSC list keep pushing meanwhile, so only the first 
+ * max nodes are detached and the rest are left in the list. A new stub node
+ * replaces the last node detached, and the chain is walked to wait for the 
+ * producers that didn't link their node yet.
+ * 
+ * @param list Linked list.
+ * @param max Maximum number of nodes to detach from a LIST_MPSC list.
+ * @param last Pointer to the variable to which will be copied the last node
+ *             of the chain.
+ * @param count Pointer to the variable to which will be copied the number of
+ *              nodes of the chain.
+ * 
+ * @return First node of the chain, NULL if the list is empty.
+ *
+ */
+/*****************************************************************************/
+static node_t*
+_list_detach_all(list_t* list, size_t max, node_t** last, size_t* count)
+{
+    node_t* first = NULL;
+    node_t* stub = list->head;
+    node_t* iterator = NULL;
+    node_t* expected = NULL;
+    node_t* next = NULL;
+
+    FINGER_RESET(list);
+
+    *count = 0;
+    *last = NULL;
+
+    if (list->flags & LIST_MPSC)
+      {
+          iterator = stub;
+          while (*count < max)
+            {
+                next = NODE_NEXT(iterator);
+                if (next == NULL)
+                  {
+                      if (__atomic_load_n(&(list->tail), __ATOMIC_ACQUIRE) == 
+                          iterator)
+                        {
+                            break;
+                        }
+
+                      // A producer swapped the tail but didn't link its node
+                      sched_yield();
+                      continue;
+                  }
+
+                iterator = next;
+                (*count)++;
+            }
+
+          if (*count == 0)
+            {
+                return NULL;
+            }
+
+          // The producers that swap the tail from now on link to the new 
+          // stub. If the last node detached is no longer the tail, the stub
+          // is put in front of the nodes that follow it instead.
+          list->head = create_node(list, NULL);
+          expected = iterator;
+          if (!__atomic_compare_exchange_n(&(list->tail), &expected, 
+                                           list->head, 0, __ATOMIC_ACQ_REL, 
+                                           __ATOMIC_ACQUIRE))
+            {
+                while ((next = NODE_NEXT(iterator)) == NULL)
+                  {
+                      sched_yield();
+                  }
+                list->head->next = next;
+                iterator->next = NULL;
+            }
+
+          first = stub->next;
+          *last = iterator;
+          free_node(list, stub);
+          atomic_fetch_sub(&(list->numElements), *count);
+      }
+    else if (list->flags & LIST_TWO_LOCK)
+      {
+          first = stub->next;
+          if (first != NULL)
+            {
+                *last = list->tail;
+                *count = list->numElements;
+            }
+          stub->next = NULL;
+          list->tail = stub;
+          list->numElements = 0;
+      }
+    else
+      {
+          first = list->head;
+          *last = list->tail;
+          *count = list->numElements;
+          list->head = NULL;
+          list->tail = NULL;
+          atomic_store_explicit(&(list->numElements), 0, 
+                                memory_order_relaxed);
+      }
+
+    return first;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to add a chain of nodes to the end of the list. It 
+ * must be called with all the locks of the list taken. In a LIST_MPSC list
+ * the elements must have been counted beforehand.
+ * 
+ * @param list Linked list.
+ * @param first First node of the chain.
+ * @param last Last node of the chain.
+ * @param count Number of nodes of the chain.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_attach_all(list_t* list, node_t* first, node_t* last, size_t count)
+{
+    node_t* prev = NULL;
+
+    if (list->flags & LIST_MPSC)
+      {
+          prev = __atomic_exchange_n(&(list->tail), last, __ATOMIC_ACQ_REL);
+          __atomic_store_n(&(prev->next), first, __ATOMIC_RELEASE);
+      }
+    else if (list->flags & LIST_TWO_LOCK)
+      {
+          list->numElements += count;
+          __atomic_store_n(&(list->tail->next), first, __ATOMIC_RELEASE);
+          list->tail = last;
+      }
+    else
+      {
+          _list_append_chain(list, first, last, count);
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to move all the nodes of a list to the end of 
+ * another one, leaving the source list empty. The nodes are relinked without
+ * copying their data, in constant time except for a LIST_MPSC source list,
+ * which is walked to wait for the producers in progress. Both lists must 
+ * hold elements of the same size, have the same LIST_DOUBLY_LINKED and 
+ * LIST_DWELL_TIME flags, and not use a node pool. A bounded destination list
+ * must have room for all the elements.
+ * 
+ * @param dst Linked list to which the nodes are moved.
+ * @param src Linked list from which the nodes are moved.
+ * 
+ * @return 1 if the lists can't be spliced, 0 otherwise.
+ * 
+ * \b Example:
+ * @code
+ *      uint8_t error = list_splice(&dst, &src);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+list_splice(list_t* dst, list_t* src)
+{
+    node_t* first = NULL;
+    node_t* last = NULL;
+    size_t reserved;
+    size_t room;
+    size_t count = 0;
+    uint8_t retval = 0;
+
+    if (dst == src || dst->dataSize != src->dataSize || 
+        (dst->flags & LIST_NODE_LAYOUT) != (src->flags & LIST_NODE_LAYOUT) ||
+        dst->pool.nodesPerChunk > 0 || src->pool.nodesPerChunk > 0)
+      {
+          return 1;
+      }
+
+    _list_lock_pair(dst, src);
+        // The producers of a MPSC list don't take the lock, so the room for
+        // the elements is reserved before detaching them. Elements pushed to
+        // a MPSC source from now on are left in it.
+        reserved = src->numElements;
+        if (dst->flags & LIST_MPSC)
+          {
+              room = _list_reserve_n(dst, reserved);
+              if (room != reserved)
+                {
+                    atomic_fetch_sub(&(dst->numElements), room);
+                    retval = 1;
+                }
+          }
+        else if (dst->capacity > 0 && 
+                 dst->numElements + reserved > dst->capacity)
+          {
+              retval = 1;
+          }
+
+        if (retval == 0)
+          {
+              first = _list_detach_all(src, reserved, &last, &count);
+
+              if (count > 0)
+                {
+                    _list_attach_all(dst, first, last, count);
+                }
+
+              if (dst->flags & LIST_MPSC)
+                {
+                    atomic_fetch_sub(&(dst->numElements), reserved - count);
+                }
+          }
+    _list_unlock_pair(dst, src);
+
+    if (count > 0)
+      {
+          STATS_WATERMARK(dst);
+          _list_signal(dst, &(dst->numPopWaiters), &(dst->notEmpty), count);
+
+          if (src->capacity > 0)
+            {
+                _list_signal(src, &(src->numPushWaiters), &(src->notFull), 
+                             count);
+            }
+      }
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to move all the nodes of the list to a new list in a
+ * single critical section, so they can be processed without contending with 
+ * the producers. The new list is initialized with the element size and the 
+ * doubly linked mode of the source list, it must be destroyed by the caller.
+ * The source list must not use a node pool.
+ * 
+ * @param list Linked list from which the nodes are moved.
+ * @param out Linked list to initialize with the nodes.
+ * 
+ * @return 1 if the list uses a node pool, 0 otherwise.
+ * 
+ * \b Example:
+ * @code
+ *      list_t backlog;
+ *      list_take_all(&list, &backlog);
+ *      while (list_pop_front(&backlog, (void *) &data) == 0)
+ *        {
+ *            ...
+ *        }
+ *      list_destroy(&backlog);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+list_take_all(list_t* list, list_t* out)
+{
+    list_config_t config = {0};
+
+    if (list->pool.nodesPerChunk > 0)
+      {
+          return 1;
+      }
+
+    config.flags = list->flags & LIST_NODE_LAYOUT;
+    list_init_config(out, list->dataSize, &config);
+
+    return list_splice(out, list);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to try to get the node at the front of the list. The
+ * threads waiting for room are not woken up, so it can be called by 
+ * _list_wait with the wait lock taken.
+ * 
+ * @param list Linked list.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             node at the front of the list.
+ * 
+ * @return 1 if there are no elements, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_list_try_pop_front(list_t* list, void* data)
+{
+    uint8_t retval;
+
+    _list_lock(list);
+        if (list->flags & LIST_STUB_MODES)
+          {
+              retval = _list_pop_front_stub(list, data);
+          }
+        else
+          {
+              retval = _list_pop_front(list, data);
+          }
+    _list_unlock(list);
+
+    STATS_POPPED(list, (retval == 0) ? 1 : 0);
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the node at the front of the list.
+ * 
+ * @param list Linked list.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             node at the front of the list.
+ * 
+ * @return 1 if there are no elements, 0 otherwise.
+ * 
+ * \b Example:
+ * @code
+ *      uint8_t error = list_pop_front(&list, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+list_pop_front(list_t* list, void* data)
+{
+    uint8_t retval = _list_try_pop_front(list, data);
+
+    if (retval == 0 && list->capacity > 0)
+      {
+          _list_signal(list, &(list->numPushWaiters), &(list->notFull), 1);
+      }
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to wake up the threads waiting on a condition of the 
+ * list. The condition is only signalled if there is a thread waiting, so 
+ * the wait lock is not taken when nobody is waiting.
+ * 
+ * @param list Linked list.
+ * @param numWaiters Number of threads waiting on the condition.
+ * @param cond Condition to signal.
+ * @param count Number of elements pushed or popped, all the waiting threads 
+ *              are woken up if it is greater than 1.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_signal(list_t* list, 
+             atomic_size_t* numWaiters, 
+             pthread_cond_t* cond, 
+             size_t count)
+{
+    // Both ends of a list with a stub node don't share a lock, so the change
+    // must be visible before the waiter count is read (the waiters increment
+    // the count before checking the list)
+    if (list->flags & LIST_STUB_MODES)
+      {
+          atomic_thread_fence(memory_order_seq_cst);
+      }
+
+    if (atomic_load_explicit(numWaiters, memory_order_relaxed) > 0)
+      {
+          pthread_mutex_lock(&(list->waitLock));
+              if (count > 1)
+                {
+                    pthread_cond_broadcast(cond);
+                }
+              else
+                {
+                    pthread_cond_signal(cond);
+                }
+          pthread_mutex_unlock(&(list->waitLock));
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to retry an operation on the list with the wait lock
+ * taken until it succeeds, the timeout expires or the list is closed. tryFn 
+ * must not wake up the other threads, as _list_signal takes the wait lock.
+ * 
+ * @param list Linked list.
+ * @param tryFn Pointer to the function that tries the operation, it returns
+ *              0 on success.
+ * @param arg Argument passed to tryFn.
+ * @param timeoutMs Maximum time to wait in milliseconds, LIST_WAIT_FOREVER to
+ *                  wait without limit.
+ * @param numWaiters Number of threads waiting on the condition.
+ * @param cond Condition signalled when the operation may succeed.
+ * 
+ * @return 0 if the operation succeeded, 1 if the timeout expired, 2 if the
+ *         list is closed.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_list_block(list_t* list, 
+            uint8_t (*tryFn)(list_t* list, void* arg), 
+            void* arg, 
+            uint32_t timeoutMs, 
+            atomic_size_t* numWaiters, 
+            pthread_cond_t* cond)
+{
+    struct timespec deadline;
+    uint8_t retval;
+    int status = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeoutMs / 1000;
+    deadline.tv_nsec += (long) (timeoutMs % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L)
+      {
+          deadline.tv_sec++;
+          deadline.tv_nsec -= 1000000000L;
+      }
+
+    pthread_mutex_lock(&(list->waitLock));
+        atomic_fetch_add(numWaiters, 1);
+        atomic_thread_fence(memory_order_seq_cst);
+
+        for (;;)
+          {
+              retval = tryFn(list, arg);
+
+              if (retval == 0)
+                {
+                    break;
+                }
+              else if (atomic_load(&(list->closed)))
+                {
+                    retval = 2;
+                    break;
+                }
+              else if (status == ETIMEDOUT)
+                {
+                    retval = 1;
+                    break;
+                }
+
+              if (timeoutMs == LIST_WAIT_FOREVER)
+                {
+                    pthread_cond_wait(cond, &(list->waitLock));
+                }
+              else
+                {
+                    status = pthread_cond_timedwait(cond, &(list->waitLock), 
+                                                    &deadline);
+                }
+          }
+
+        atomic_fetch_sub(numWaiters, 1);
+    pthread_mutex_unlock(&(list->waitLock));
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to retry an operation on the list until it succeeds,
+ * the timeout expires or the list is closed. The wait lock is only taken if
+ * the first try fails. The threads waiting on the other end are woken up 
+ * after the wait lock is released.
+ * 
+ * @param list Linked list.
+ * @param tryFn Pointer to the function that tries the operation without 
+ *              waking up other threads, it returns 0 on success.
+ * @param arg Argument passed to tryFn.
+ * @param timeoutMs Maximum time to wait in milliseconds, LIST_WAIT_FOREVER to
+ *                  wait without limit.
+ * @param push 1 if tryFn adds an element, so it waits for room, 0 if it 
+ *             removes one, so it waits for elements.
+ * 
+ * @return 0 if the operation succeeded, 1 if the timeout expired, 2 if the
+ *         list is closed.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_list_wait(list_t* list, 
+           uint8_t (*tryFn)(list_t* list, void* arg), 
+           void* arg, 
+           uint32_t timeoutMs, 
+           uint8_t push)
+{
+    uint8_t retval = tryFn(list, arg);
+
+    if (retval != 0)
+      {
+          if (push)
+            {
+                retval = _list_block(list, tryFn, arg, timeoutMs, 
+                                     &(list->numPushWaiters), 
+                                     &(list->notFull));
+            }
+          else
+            {
+                retval = _list_block(list, tryFn, arg, timeoutMs, 
+                                     &(list->numPopWaiters), 
+                                     &(list->notEmpty));
+            }
+      }
+
+    if (retval == 0 && push)
+      {
+          _list_signal(list, &(list->numPopWaiters), &(list->notEmpty), 1);
+      }
+    else if (retval == 0 && list->capacity > 0)
+      {
+          _list_signal(list, &(list->numPushWaiters), &(list->notFull), 1);
+      }
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the node at the end of the list, waiting for
+ * an element to be pushed if the list is empty.
+ * 
+ * @param list Linked list.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             node at the end of the list.
+ * @param timeoutMs Maximum time to wait in milliseconds, LIST_WAIT_FOREVER to
+ *                  wait without limit.
+ * 
+ * @return 0 if an element was popped, 1 if the timeout expired, 2 if the list
+ *         is closed and empty.
+ * 
+ * \b Example:
+ * @code
+ *      uint8_t error = list_pop_wait(&list, (void *) &data, 100);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+list_pop_wait(list_t* list, void* data, uint32_t timeoutMs)
+{
+    return _list_wait(list, _list_try_pop, data, timeoutMs, 0);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the node at the front of the list, waiting 
+ * for an element to be pushed if the list is empty.
+ * 
+ * @param list Linked list.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             node at the front of the list.
+ * @param timeoutMs Maximum time to wait in milliseconds, LIST_WAIT_FOREVER to
+ *                  wait without limit.
+ * 
+ * @return 0 if an element was popped, 1 if the timeout expired, 2 if the list
+ *         is closed and empty.
+ * 
+ * \b Example:
+ * @code
+ *      uint8_t error = list_pop_front_wait(&list, (void *) &data, 100);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+list_pop_front_wait(list_t* list, void* data, uint32_t timeoutMs)
+{
+    return _list_wait(list, _list_try_pop_front, data, timeoutMs, 0);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to close the list and wake up all the threads 
+ * waiting for elements or for room. The elements left in the list can still
+ * be popped, once it is empty the blocking methods return immediately.
+ * 
+ * @param list Linked list.
+ * 
+ * @return None.
+ * 
+ * \b Example:
+ * @code
+ *      list_close(&list);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+list_close(list_t* list)
+{
+    pthread_mutex_lock(&(list->waitLock));
+        atomic_store(&(list->closed), 1);
+        pthread_cond_broadcast(&(list->notEmpty));
+        pthread_cond_broadcast(&(list->notFull));
+    pthread_mutex_unlock(&(list->waitLock));
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the first node of the list, skipping the stub
+ * node of a LIST_MPSC or LIST_TWO_LOCK list.
+ * 
+ * @param list Linked list.
+ * 
+ * @return A pointer to the first node, NULL if the list is empty.
+ *
+ */
+/*****************************************************************************/
+static node_t*
+_list_first(list_t* list)
+{
+    if (list->flags & LIST_STUB_MODES)
+      {
+          return NODE_NEXT(list->head);
+      }
+
+    return list->head;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to add a node to the end of a LIST_MPSC list without
+ * taking the lock. The tail is swapped atomically so concurrent producers are
+ * ordered by the exchange, then the new node is published to the consumer by
+ * linking it to the previous tail.
+ * 
+ * @param list Linked list.
+ * @param data Pointer to the variable which value will be inserted at the end 
+ *             of the list.
+ * 
+ * @return 1 if the list is full, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_list_push_mpsc(list_t* list, const void* data)
+{
+    node_t* newNode = NULL;
+    node_t* prev = NULL;
+
+    // Count the node before it is visible so the count never underflows
+    if (_list_reserve(list) != 0)
+      {
+          return 1;
+      }
+
+    newNode = create_node(list, data);
+
+    prev = __atomic_exchange_n(&(list->tail), newNode, __ATOMIC_ACQ_REL);
+    __atomic_store_n(&(prev->next), newNode, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to add a node to the end of a LIST_TWO_LOCK list. It
+ * must be called with the tail lock taken. The link is published with 
+ * release semantics because the consumer may be reading it under the head 
+ * lock.
+ * 
+ * @param list Linked list.
+ * @param newNode Node to insert at the end of the list.
+ * 
+ * @return 1 if the list is full, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_list_push_two_lock(list_t* list, node_t* newNode)
+{
+    // Count the node before it is visible so the count never underflows
+    if (_list_reserve(list) != 0)
+      {
+          return 1;
+      }
+
+    __atomic_store_n(&(list->tail->next), newNode, __ATOMIC_RELEASE);
+    list->tail = newNode;
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to count a new element of a list with a stub node 
+ * before it is linked. In a bounded list the count is only incremented if 
+ * there is room, with a compare and swap because the producers of a 
+ * LIST_MPSC list don't share a lock.
+ * 
+ * @param list Linked list.
+ * 
+ * @return 1 if the list is full, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_list_reserve(list_t* list)
+{
+    return (_list_reserve_n(list, 1) == 1) ? 0 : 1;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to count up to n new elements of a list with a stub
+ * node before they are linked. In a bounded list only the elements that fit
+ * are counted.
+ * 
+ * @param list Linked list.
+ * @param n Number of elements to count.
+ * 
+ * @return Number of elements counted.
+ *
+ */
+/*****************************************************************************/
+static size_t
+_list_reserve_n(list_t* list, size_t n)
+{
+    size_t numElements;
+    size_t count;
+
+    if (list->capacity == 0)
+      {
+          atomic_fetch_add(&(list->numElements), n);
+          return n;
+      }
+
+    numElements = atomic_load_explicit(&(list->numElements), 
+                                       memory_order_relaxed);
+    do
+      {
+          if (numElements >= list->capacity)
+            {
+                return 0;
+            }
+
+          count = list->capacity - numElements;
+          if (count > n)
+            {
+                count = n;
+            }
+      }
+    while (!atomic_compare_exchange_weak(&(list->numElements), 
+                                         &numElements, numElements + count));
+
+    return count;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to take the lock of the list, or of the head in a 
+ * LIST_TWO_LOCK list, for writing.
+ * 
+ * @param list Linked list.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_lock(list_t* list)
+{
+    if (list->flags & LIST_RWLOCK)
+      {
+          LOCK_COUNTED(list, &(list->rwlock), pthread_rwlock_wrlock, 
+                       pthread_rwlock_trywrlock, 1);
+      }
+    else
+      {
+          LOCK_COUNTED(list, &(list->lock), pthread_mutex_lock, 
+                       pthread_mutex_trylock, 1);
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to take the lock of the list for reading. In a 
+ * LIST_RWLOCK list several readers can hold it at the same time, otherwise 
+ * it is the same as _list_lock.
+ * 
+ * @param list Linked list.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_read_lock(list_t* list)
+{
+    if (list->flags & LIST_RWLOCK)
+      {
+          LOCK_COUNTED(list, &(list->rwlock), pthread_rwlock_rdlock, 
+                       pthread_rwlock_tryrdlock, 0);
+      }
+    else
+      {
+          LOCK_COUNTED(list, &(list->lock), pthread_mutex_lock, 
+                       pthread_mutex_trylock, 1);
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to release the lock taken by _list_lock or 
+ * _list_read_lock.
+ * 
+ * @param list Linked list.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_unlock(list_t* list)
+{
+    STATS_UNLOCKING(list);
+
+    if (list->flags & LIST_RWLOCK)
+      {
+          pthread_rwlock_unlock(&(list->rwlock));
+      }
+    else
+      {
+          pthread_mutex_unlock(&(list->lock));
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to take the locks needed to modify both ends of the
+ * list. In a LIST_TWO_LOCK list the head lock is always taken before the 
+ * tail lock.
+ * 
+ * @param list Linked list.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_lock_all(list_t* list)
+{
+    _list_lock(list);
+
+    if (list->flags & LIST_TWO_LOCK)
+      {
+          pthread_mutex_lock(&(list->tailLock));
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to release the locks taken by _list_lock_all.
+ * 
+ * @param list Linked list.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_unlock_all(list_t* list)
+{
+    if (list->flags & LIST_TWO_LOCK)
+      {
+          pthread_mutex_unlock(&(list->tailLock));
+      }
+
+    _list_unlock(list);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to read the monotonic clock for the statistics and 
+ * the dwell times.
+ * 
+ * @return Time in ns.
+ *
+ */
+/*****************************************************************************/
+static uint64_t
+_list_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to raise a maximum counter to a value if it is 
+ * larger.
+ * 
+ * @param max Counter of the maximum.
+ * @param value New value.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_atomic_max(atomic_uint_least64_t* max, uint64_t value)
+{
+    uint64_t current = atomic_load_explicit(max, memory_order_relaxed);
+
+    while (value > current &&
+           !atomic_compare_exchange_weak_explicit(max, &current, value,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed))
+      {
+          // current was reloaded by the failed compare and swap
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the bucket of the dwell time histogram of a 
+ * value.
+ * 
+ * @param ns Dwell time in ns.
+ * 
+ * @return Index of the bucket.
+ *
+ */
+/*****************************************************************************/
+static size_t
+_list_dwell_bucket(uint64_t ns)
+{
+    uint32_t shift;
+
+    if (ns < DWELL_SUB_BUCKETS)
+      {
+          return (size_t) ns;
+      }
+
+    // Keep the DWELL_SUB_BITS most significant bits
+    shift = (63 - __builtin_clzll(ns)) - (DWELL_SUB_BITS - 1);
+
+    return DWELL_SUB_BUCKETS + (shift - 1) * DWELL_HALF_BUCKETS + 
+           (size_t) ((ns >> shift) - DWELL_HALF_BUCKETS);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the largest value of a bucket of the dwell 
+ * time histogram.
+ * 
+ * @param bucket Index of the bucket.
+ * 
+ * @return Largest dwell time in ns that falls in the bucket.
+ *
+ */
+/*****************************************************************************/
+static uint64_t
+_list_dwell_bucket_max(size_t bucket)
+{
+    uint32_t shift;
+    uint64_t top;
+
+    if (bucket < DWELL_SUB_BUCKETS)
+      {
+          return bucket;
+      }
+
+    shift = (bucket - DWELL_SUB_BUCKETS) / DWELL_HALF_BUCKETS + 1;
+    top = (bucket - DWELL_SUB_BUCKETS) % DWELL_HALF_BUCKETS + 
+          DWELL_HALF_BUCKETS;
+
+    // The top bucket ends at UINT64_MAX, (top + 1) << shift wraps to 0
+    return ((top + 1) << shift) - 1;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to record the dwell time of a node that is being 
+ * popped. It doesn't take any lock.
+ * 
+ * @param list Linked list with the LIST_DWELL_TIME flag.
+ * @param node Node being popped.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_dwell_record(list_t* list, node_t* node)
+{
+    uint64_t ns = _list_now_ns() - NODE_STAMP(list, node);
+
+    atomic_fetch_add_explicit(&(list->dwell->buckets[_list_dwell_bucket(ns)]),
+                              1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&(list->dwell->totalNs), ns, 
+                              memory_order_relaxed);
+    _list_atomic_max(&(list->dwell->maxNs), ns);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to get a percentile of the dwell time histogram.
+ * 
+ * @param dwell Dwell time histogram.
+ * @param count Number of values in the buckets.
+ * @param perMille Percentile in thousandths.
+ * 
+ * @return Largest value of the bucket where the percentile falls, in ns.
+ *
+ */
+/*****************************************************************************/
+static uint64_t
+_list_dwell_percentile(list_dwell_t* dwell, uint64_t count, uint32_t perMille)
+{
+    // Rank of the value, rounded up so that p100 is the last value
+    uint64_t rank = (count * perMille + 999) / 1000;
+    uint64_t seen = 0;
+    size_t i;
+
+    if (rank == 0)
+      {
+          rank = 1;
+      }
+
+    for (i = 0; i < DWELL_BUCKETS; i++)
+      {
+          seen += atomic_load_explicit(&(dwell->buckets[i]), 
+                                       memory_order_relaxed);
+          if (seen >= rank)
+            {
+                return _list_dwell_bucket_max(i);
+            }
+      }
+
+    return _list_dwell_bucket_max(DWELL_BUCKETS - 1);
+}
+
+#if LIST_STATS
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to count the elements added by a push method and to
+ * update the high-water mark of the number of elements.
+ * 
+ * @param list Linked list.
+ * @param n Number of elements pushed, 0 to only update the high-water mark.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_stats_pushed(list_t* list, size_t n)
+{
+    size_t numElements = atomic_load_explicit(&(list->numElements), 
+                                              memory_order_relaxed);
+    size_t current = atomic_load_explicit(&(list->stats.highWaterMark), 
+                                          memory_order_relaxed);
+
+    if (n > 0)
+      {
+          atomic_fetch_add_explicit(&(list->stats.pushes), n, 
+                                    memory_order_relaxed);
+      }
+
+    while (numElements > current &&
+           !atomic_compare_exchange_weak_explicit(&(list->stats.highWaterMark),
+                                                  &current, numElements,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed))
+      {
+          // current was reloaded by the failed compare and swap
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to count the elements removed by a pop method.
+ * 
+ * @param list Linked list.
+ * @param n Number of elements popped, 0 if the list was empty.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_stats_popped(list_t* list, size_t n)
+{
+    if (n > 0)
+      {
+          atomic_fetch_add_explicit(&(list->stats.pops), n, 
+                                    memory_order_relaxed);
+      }
+    else
+      {
+          atomic_fetch_add_explicit(&(list->stats.failedPops), 1, 
+                                    memory_order_relaxed);
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to count an acquisition of the lock of the list. It
+ * must be called right after taking it.
+ * 
+ * @param list Linked list.
+ * @param contended 1 if the lock was busy, 0 otherwise.
+ * @param exclusive 1 if no other thread can hold the lock now, 0 for the 
+ *                  readers of a LIST_RWLOCK list.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_stats_locked(list_t* list, uint8_t contended, uint8_t exclusive)
+{
+    atomic_fetch_add_explicit(&(list->stats.lockAcquisitions), 1, 
+                              memory_order_relaxed);
+
+    if (contended)
+      {
+          atomic_fetch_add_explicit(&(list->stats.contendedAcquisitions), 1, 
+                                    memory_order_relaxed);
+      }
+
+    if (exclusive)
+      {
+          list->stats.lockedAt = _list_now_ns();
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to add the time the lock was held to the statistics.
+ * It must be called right before releasing it. The readers of a LIST_RWLOCK 
+ * list find lockedAt cleared and don't record anything.
+ * 
+ * @param list Linked list.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_stats_unlocking(list_t* list)
+{
+    uint64_t held;
+
+    if (list->stats.lockedAt == 0)
+      {
+          return;
+      }
+
+    held = _list_now_ns() - list->stats.lockedAt;
+    list->stats.lockedAt = 0;
+
+    atomic_fetch_add_explicit(&(list->stats.lockHoldNs), held, 
+                              memory_order_relaxed);
+    _list_atomic_max(&(list->stats.maxLockHoldNs), held);
+}
+#endif
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to add a node to the front of a list with a stub 
+ * node. It must be called with the head lock taken (and the tail lock in a
+ * LIST_TWO_LOCK list). If the list is empty the stub node is the tail, so the
+ * new node takes its place with a compare and swap to not race with the 
+ * producers of a LIST_MPSC list.
+ * 
+ * @param list Linked list.
+ * @param data Pointer to the variable which value will be inserted at the 
+ *             front of the list.
+ * 
+ * @return 1 if the list is full, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_list_push_front_stub(list_t* list, const void* data)
+{
+    node_t* newNode = NULL;
+    node_t* stub = list->head;
+    node_t* first = NULL;
+    node_t* expected = NULL;
+
+    FINGER_RESET(list);
+
+    if (_list_reserve(list) != 0)
+      {
+          return 1;
+      }
+
+    newNode = create_node(list, data);
+
+    for (;;)
+      {
+          first = NODE_NEXT(stub);
+
+          if (first != NULL)
+            {
+                newNode->next = first;
+                break;
+            }
+
+          expected = stub;
+          if (__atomic_compare_exchange_n(&(list->tail), &expected, newNode, 0,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            {
+                break;
+            }
+
+          // A producer swapped the tail but didn't link its node yet
+          sched_yield();
+      }
+
+    __atomic_store_n(&(stub->next), newNode, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the node at the end of a list with a stub 
+ * node. It must be called with the head lock taken (and the tail lock in a
+ * LIST_TWO_LOCK list). The last node is only removed if the tail can be moved
+ * back to its previous node before any producer of a LIST_MPSC list links a 
+ * new node to it.
+ * 
+ * @param list Linked list.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             node at the end of the list.
+ * 
+ * @return 1 if there are no elements, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_list_pop_stub(list_t* list, void* data)
+{
+    node_t* prev = list->head;
+    node_t* last = NODE_NEXT(prev);
+    node_t* next = NULL;
+    node_t* expected = NULL;
+
+    FINGER_RESET(list);
+
+    if (last == NULL)
+      {
+          return 1;
+      }
+
+    for (;;)
+      {
+          // Get the last node published by the producers
+          while ((next = NODE_NEXT(last)) != NULL)
+            {
+                prev = last;
+                last = next;
+            }
+
+          // Producers never read the links, only the tail
+          __atomic_store_n(&(prev->next), NULL, __ATOMIC_RELAXED);
+
+          expected = last;
+          if (__atomic_compare_exchange_n(&(list->tail), &expected, prev, 0,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            {
+                break;
+            }
+
+          // A producer appended a node, restore the link and keep walking
+          __atomic_store_n(&(prev->next), last, __ATOMIC_RELAXED);
+          sched_yield();
+      }
+
+    if (data != NULL)
+      {
+          memcpy(data, last->data, list->dataSize);
+      }
+    DWELL_RECORD(list, last);
+    free_node(list, last);
     list->numElements--;
-    list->tail = iterator;
 
-    return 0;
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the node at the front of a list with a stub 
+ * node. It must be called with the head lock taken. The first node becomes 
+ * the new stub node and the old stub node is released.
+ * 
+ * @param list Linked list.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             node at the front of the list.
+ * 
+ * @return 1 if there are no elements, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_list_pop_front_stub(list_t* list, void* data)
+{
+    node_t* stub = list->head;
+    node_t* first = NODE_NEXT(stub);
+
+    FINGER_RESET(list);
+
+    // Empty, or the producer of the first node didn't link it yet
+    if (first == NULL)
+      {
+          return 1;
+      }
+
+    if (data != NULL)
+      {
+          memcpy(data, first->data, list->dataSize);
+      }
+    DWELL_RECORD(list, first);
+    list->head = first;
+    free_node(list, stub);
+    list->numElements--;
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the value of a node at a given index.
+ * It doesn't delete the node.
+ * 
+ * @param list Linked list.
+ * @param index Index of the node.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             node at the given index.
+ * 
+ * @return 1 if the given index is out of limits, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_list_get_by_index(list_t* list, size_t index, void* data)
+{
+    node_t* node = _list_node_at(list, index);
+
+    if (node == NULL)
+      {
+          return 1;
+      }
+
+    memcpy(data, node->data, list->dataSize);
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to get a pointer to the value of the node at the 
+ * front of the list without copying it. If the list is not empty it is left
+ * locked, so the pointer is valid until list_peek_end is called. The value
+ * can be modified in place but the list can't be used by the same thread in
+ * the meantime.
+ * 
+ * @param list Linked list.
+ * 
+ * @return Pointer to the value of the node, NULL if the list is empty (the 
+ *         list is not left locked).
+ * 
+ * \b Example:
+ * @code
+ *      record_t* record = list_peek_front(&list);
+ *      if (record != NULL)
+ *        {
+ *            process(record);
+ *            list_peek_end(&list);
+ *        }
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void*
+list_peek_front(list_t* list)
+{
+    return list_peek_at(list, 0);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to get a pointer to the value of the node at a given
+ * index without copying it. If the index is within the limits of the list, 
+ * the list is left locked until list_peek_end is called.
+ * 
+ * @param list Linked list.
+ * @param index Index of the node.
+ * 
+ * @return Pointer to the value of the node, NULL if the index is out of 
+ *         limits (the list is not left locked).
+ * 
+ * \b Example:
+ * @code
+ *      record_t* record = list_peek_at(&list, 3);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void*
+list_peek_at(list_t* list, size_t index)
+{
+    node_t* node;
+
+    _list_lock(list);
+    node = _list_node_at(list, index);
+
+    if (node == NULL)
+      {
+          _list_unlock(list);
+          return NULL;
+      }
+
+    return node->data;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to unlock the list after a successful list_peek_front
+ * or list_peek_at. The pointer returned by them is no longer valid.
+ * 
+ * @param list Linked list.
+ * 
+ * @return None.
+ * 
+ * \b Example:
+ * @code
+ *      list_peek_end(&list);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+list_peek_end(list_t* list)
+{
+    _list_unlock(list);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the node at a given index. The node found is
+ * kept as the finger of the list, and the next call starts walking from it 
+ * if its index is not greater, so accessing the indexes in order is O(1) 
+ * amortised. The finger is not used in a LIST_RWLOCK list, whose readers 
+ * would update it concurrently.
+ * 
+ * @param list Linked list.
+ * @param index Index of the node.
+ * 
+ * @return Node at the given index, NULL if the index is out of limits.
+ *
+ */
+/*****************************************************************************/
+static node_t*
+_list_node_at(list_t* list, size_t index)
+{
+    size_t i = 0;
+    node_t* iterator = _list_first(list);
+    uint8_t useFinger = !(list->flags & LIST_RWLOCK);
+
+    // Check if index is between limits of linked list
+    if(index >= list->numElements)
+      {
+          return NULL;
+      }
+
+    // Continue from the last node accessed if it is not past the index, so
+    // sequential indexes don't walk from the head every time
+    if (useFinger && list->finger != NULL && list->fingerIndex <= index)
+      {
+          iterator = list->finger;
+          i = list->fingerIndex;
+      }
+
+    // The producers of a MPSC list count a node before linking it
+    for(; i < index && iterator != NULL; i++)
+      {
+          iterator = NODE_NEXT(iterator);
+      }
+
+    if (useFinger && iterator != NULL)
+      {
+          list->finger = iterator;
+          list->fingerIndex = index;
+      }
+
+    return iterator;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the value of a node at a given index.
+ * It doesn't delete the node. The list is walked to the node, so random 
+ * indexes take O(n). The Indexed Skip List (Skip_list.h) gets them in 
+ * O(log n).
+ * 
+ * @param list Linked list.
+ * @param index Index of the node.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             node at the given index.
+ * 
+ * @return 1 if the given index is out of limits, 0 otherwise.
+ * 
+ * \b Example:
+ * @code
+ *      uint8_t error = list_get_by_index(&list, index, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t 
+list_get_by_index(list_t* list, size_t index, void* data)
+{
+    uint8_t retval;
+
+    _list_read_lock(list);
+        retval = _list_get_by_index(list, index, data);
+    _list_unlock(list);
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the node before a given index, the one the
+ * node at that index is linked to.
+ * 
+ * @param list Linked list.
+ * @param index Index of the node.
+ * 
+ * @return Node before the given index. For the index 0 it is the stub, or 
+ *         NULL in a list without a stub node. It is also NULL if the node 
+ *         was not linked yet by a producer of a LIST_MPSC list.
+ *
+ */
+/*****************************************************************************/
+static node_t*
+_list_node_before(list_t* list, size_t index)
+{
+    if (index > 0)
+      {
+          return _list_node_at(list, index - 1);
+      }
+
+    return (list->flags & LIST_STUB_MODES) ? list->head : NULL;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to unlink the node that follows a given node 
+ * without freeing it. It must be called with the head lock taken.
+ * 
+ * @param list Linked list.
+ * @param prev Node before the one to unlink, NULL to unlink the head of a 
+ *             list without a stub node.
+ * 
+ * @return Node unlinked, NULL if there is no node after prev.
+ *
+ */
+/*****************************************************************************/
+static node_t*
+_list_detach_after(list_t* list, node_t* prev)
+{
+    node_t* node = NULL;
+
+    if (list->flags & LIST_STUB_MODES)
+      {
+          return (prev != NULL) ? _list_detach_after_stub(list, prev) : NULL;
+      }
+
+    node = (prev != NULL) ? prev->next : list->head;
+    if (node == NULL)
+      {
+          return NULL;
+      }
+
+    if (prev != NULL)
+      {
+          prev->next = node->next;
+      }
+    else
+      {
+          list->head = node->next;
+      }
+
+    if (node->next == NULL)
+      {
+          list->tail = prev;
+      }
+    else if (list->flags & LIST_DOUBLY_LINKED)
+      {
+          NODE_PREV(node->next) = prev;
+      }
+
+    COUNT_SUB(list, 1);
+
+    node->next = NULL;
+    return node;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to insert a node at a given index. It must be 
+ * called with the locks of both ends taken. In a list with a stub node an 
+ * insertion after the last linked node is a push, so it doesn't race with 
+ * the producers.
+ * 
+ * @param list Linked list.
+ * @param index Index the new node will have, up to the number of elements.
+ * @param data Pointer to the variable which value will be inserted.
+ * 
+ * @return 1 if the index is out of limits or the list is full, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_list_insert_at(list_t* list, size_t index, const void* data)
+{
+    node_t* prev = NULL;
+    node_t* next = NULL;
+    node_t* newNode = NULL;
+    uint8_t retval = 0;
+
+    if (index > list->numElements)
+      {
+          return 1;
+      }
+
+    if (index == 0)
+      {
+          FINGER_RESET(list);
+      }
+
+    if (list->flags & LIST_STUB_MODES)
+      {
+          if (index == 0)
+            {
+                return _list_push_front_stub(list, data);
+            }
+
+          prev = _list_node_before(list, index);
+          next = (prev != NULL) ? NODE_NEXT(prev) : NULL;
+
+          if (next == NULL && (list->flags & LIST_MPSC))
+            {
+                return _list_push_mpsc(list, data);
+            }
+          else if (next == NULL)
+            {
+                newNode = create_node(list, data);
+                retval = _list_push_two_lock(list, newNode);
+                if (retval != 0)
+                  {
+                      free_node(list, newNode);
+                  }
+
+                return retval;
+            }
+
+          // The producers only link nodes to the tail, which is further
+          if (_list_reserve(list) != 0)
+            {
+                return 1;
+            }
+
+          newNode = create_node(list, data);
+          newNode->next = next;
+          __atomic_store_n(&(prev->next), newNode, __ATOMIC_RELEASE);
+
+          return 0;
+      }
+
+    if (LIST_IS_FULL(list))
+      {
+          return 1;
+      }
+
+    _list_link_after(list, _list_node_before(list, index), 
+                     create_node(list, data));
+    COUNT_ADD(list, 1);
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to link a node after a given node. It doesn't 
+ * update the number of elements. It must be called with the locks of both 
+ * ends taken, and not in a LIST_MPSC list, whose producers link nodes to 
+ * the tail without the lock.
+ * 
+ * @param list Linked list.
+ * @param prev Node after which the new node is linked, NULL to link it at 
+ *             the head of a list without a stub node.
+ * @param newNode Node to be linked.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_link_after(list_t* list, node_t* prev, node_t* newNode)
+{
+    newNode->next = (prev != NULL) ? prev->next : list->head;
+
+    if (prev != NULL)
+      {
+          __atomic_store_n(&(prev->next), newNode, __ATOMIC_RELEASE);
+      }
+    else
+      {
+          list->head = newNode;
+      }
+
+    if (newNode->next == NULL)
+      {
+          list->tail = newNode;
+      }
+
+    if (list->flags & LIST_DOUBLY_LINKED)
+      {
+          NODE_PREV(newNode) = prev;
+
+          if (newNode->next != NULL)
+            {
+                NODE_PREV(newNode->next) = newNode;
+            }
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to insert an element at a given index. The elements
+ * from that index on are moved one position back. If the list is bounded 
+ * and full it fails without waiting nor dropping elements.
+ * 
+ * @param list Linked list.
+ * @param index Index the new element will have, up to the number of 
+ *              elements.
+ * @param data Pointer to the variable which value will be inserted.
+ * 
+ * @return 1 if the index is out of limits or the list is full, 0 otherwise.
+ * 
+ * \b Example:
+ * @code
+ *      uint8_t error = list_insert_at(&list, 3, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+list_insert_at(list_t* list, size_t index, const void* data)
+{
+    uint8_t retval;
+
+    _list_lock_all(list);
+        retval = _list_insert_at(list, index, data);
+    _list_unlock_all(list);
+
+    if (retval == 0)
+      {
+          STATS_PUSHED(list, 1);
+          _list_signal(list, &(list->numPopWaiters), &(list->notEmpty), 1);
+      }
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to get and delete the element at a given index. 
+ * 
+ * @param list Linked list.
+ * @param index Index of the element.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element, or NULL to discard it.
+ * 
+ * @return 1 if the index is out of limits, 0 otherwise.
+ * 
+ * \b Example:
+ * @code
+ *      uint8_t error = list_remove_at(&list, 3, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+list_remove_at(list_t* list, size_t index, void* data)
+{
+    node_t* node = NULL;
+
+    _list_lock(list);
+        if (index == 0)
+          {
+              FINGER_RESET(list);
+          }
+
+        if (index < list->numElements)
+          {
+              node = _list_detach_after(list, _list_node_before(list, index));
+          }
+
+        if (node != NULL && data != NULL)
+          {
+              memcpy(data, node->data, list->dataSize);
+          }
+
+        if (node != NULL)
+          {
+              free_node(list, node);
+          }
+    _list_unlock(list);
+
+    if (node == NULL)
+      {
+          return 1;
+      }
+
+    STATS_POPPED(list, 1);
+
+    if (list->capacity > 0)
+      {
+          _list_signal(list, &(list->numPushWaiters), &(list->notFull), 1);
+      }
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to delete every element for which a predicate is 
+ * true, in a single pass with the lock taken once. The nodes are unlinked 
+ * in place, the elements kept are not moved nor copied.
+ * 
+ * @param list Linked list.
+ * @param predFn Pointer to the predicate. It receives a pointer to the 
+ *               element and arg, and returns non zero to delete it.
+ * @param arg Argument passed to predFn.
+ * 
+ * @return Number of elements deleted.
+ * 
+ * \b Example:
+ * @code
+ *      size_t removed = list_remove_if(&list, isExpired, (void *) &now);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+size_t
+list_remove_if(list_t* list, 
+               uint8_t (*predFn)(const void* data, void* arg), 
+               void* arg)
+{
+    node_t* prev = NULL;
+    node_t* iterator = NULL;
+    size_t count = 0;
+
+    _list_lock(list);
+        FINGER_RESET(list);
+
+        prev = _list_node_before(list, 0);
+        iterator = _list_first(list);
+
+        while (iterator != NULL)
+          {
+              if (!predFn(iterator->data, arg))
+                {
+                    prev = iterator;
+                    iterator = NODE_NEXT(iterator);
+                    continue;
+                }
+
+              free_node(list, _list_detach_after(list, prev));
+              count++;
+
+              iterator = (prev != NULL) ? NODE_NEXT(prev) : list->head;
+          }
+    _list_unlock(list);
+
+    if (count > 0)
+      {
+          STATS_POPPED(list, count);
+      }
+
+    if (count > 0 && list->capacity > 0)
+      {
+          _list_signal(list, &(list->numPushWaiters), &(list->notFull), 
+                       count);
+      }
+
+    return count;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the value of the first element that matches 
+ * a key. It doesn't delete the element.
+ * 
+ * @param list Linked list.
+ * @param cmpFn Pointer to the comparison function. It receives a pointer to
+ *              the element and the key, and returns 0 if they match.
+ * @param key Key passed to cmpFn.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element found, or NULL.
+ * 
+ * @return 1 if no element matches the key, 0 otherwise.
+ * 
+ * \b Example:
+ * @code
+ *      uint8_t error = list_find(&list, compareId, (void *) &id, 
+ *                                (void *) &record);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+list_find(list_t* list, 
+          int (*cmpFn)(const void* data, const void* key), 
+          const void* key, 
+          void* data)
+{
+    node_t* iterator = NULL;
+
+    _list_read_lock(list);
+        iterator = _list_first(list);
+
+        while (iterator != NULL && cmpFn(iterator->data, key) != 0)
+          {
+              iterator = NODE_NEXT(iterator);
+          }
+
+        if (iterator != NULL && data != NULL)
+          {
+              memcpy(data, iterator->data, list->dataSize);
+          }
+    _list_unlock(list);
+
+    return (iterator == NULL);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to merge two sorted chains of nodes by relinking 
+ * them. On equal elements the node of the first chain goes first.
+ * 
+ * @param first First sorted chain, its elements precede the second ones.
+ * @param second Second sorted chain.
+ * @param cmpFn Pointer to the comparison function.
+ * @param last Pointer where the last node of the merged chain is stored, 
+ *             or NULL if it is not needed.
+ * 
+ * @return First node of the merged chain.
+ *
+ */
+/*****************************************************************************/
+static node_t*
+_list_merge_chains(node_t* first, 
+                   node_t* second, 
+                   int (*cmpFn)(const void* data, const void* key), 
+                   node_t** last)
+{
+    node_t* merged = NULL;
+    node_t** link = &merged;
+    node_t* tail = NULL;
+
+    while (first != NULL && second != NULL)
+      {
+          if (cmpFn(first->data, second->data) <= 0)
+            {
+                tail = first;
+                first = first->next;
+            }
+          else
+            {
+                tail = second;
+                second = second->next;
+            }
+
+          *link = tail;
+          link = &(tail->next);
+      }
+
+    *link = (first != NULL) ? first : second;
+
+    // The rest of the longer chain is walked to find the last node
+    if (last != NULL)
+      {
+          while (tail->next != NULL)
+            {
+                tail = tail->next;
+            }
+          *last = tail;
+      }
+
+    return merged;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to sort a chain of nodes with a bottom-up merge 
+ * sort. The nodes are taken one by one and merged like a binary counter: 
+ * bin i holds a sorted run of 2^i nodes or nothing, and a new run is merged
+ * with the full bins below the first empty one. The runs merged are the 
+ * ones visited last, which keeps them in the cache, no memory is allocated 
+ * and equal elements keep their order.
+ * 
+ * @param first First node of the chain, terminated by a NULL link.
+ * @param cmpFn Pointer to the comparison function.
+ * @param last Pointer where the last node of the sorted chain is stored.
+ * 
+ * @return First node of the sorted chain.
+ *
+ */
+/*****************************************************************************/
+static node_t*
+_list_sort_chain(node_t* first, 
+                 int (*cmpFn)(const void* data, const void* key), 
+                 node_t** last)
+{
+    node_t* bins[LIST_SORT_BINS] = {NULL};
+    node_t* run = NULL;
+    node_t* sorted = NULL;
+    size_t top;
+    size_t i;
+
+    while (first != NULL)
+      {
+          run = first;
+          first = first->next;
+          run->next = NULL;
+
+          // The runs in the bins precede the new one
+          for (i = 0; i < LIST_SORT_BINS - 1 && bins[i] != NULL; i++)
+            {
+                run = _list_merge_chains(bins[i], run, cmpFn, NULL);
+                bins[i] = NULL;
+            }
+          bins[i] = run;
+      }
+
+    // The largest run is merged last, so only that merge looks for the tail
+    top = LIST_SORT_BINS - 1;
+    while (bins[top] == NULL)
+      {
+          top--;
+      }
+
+    for (i = 0; i < top; i++)
+      {
+          if (bins[i] != NULL)
+            {
+                sorted = (sorted == NULL) ? bins[i] : 
+                         _list_merge_chains(bins[i], sorted, cmpFn, NULL);
+            }
+      }
+
+    if (sorted != NULL)
+      {
+          return _list_merge_chains(bins[top], sorted, cmpFn, last);
+      }
+
+    *last = bins[top];
+    while ((*last)->next != NULL)
+      {
+          *last = (*last)->next;
+      }
+
+    return bins[top];
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to sort the elements of the list in place, in 
+ * O(n log n) and without allocating memory. The nodes are relinked, the 
+ * elements are not copied, and equal elements keep their order. It is not 
+ * available in a LIST_MPSC list, whose producers append without the lock.
+ * 
+ * @param list Linked list.
+ * @param cmpFn Pointer to the comparison function. It receives pointers to 
+ *              two elements and returns a negative value, 0 or a positive 
+ *              value if the first is less than, equal to or greater than the
+ *              second.
+ * 
+ * @return 1 if the list is a LIST_MPSC list, 0 otherwise.
+ * 
+ * \b Example:
+ * @code
+ *      uint8_t error = list_sort(&list, compareInt);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+list_sort(list_t* list, int (*cmpFn)(const void* data, const void* key))
+{
+    node_t* first = NULL;
+    node_t* last = NULL;
+    node_t* prev = NULL;
+    node_t* iterator = NULL;
+
+    if (list->flags & LIST_MPSC)
+      {
+          return 1;
+      }
+
+    _list_lock_all(list);
+        FINGER_RESET(list);
+        first = _list_first(list);
+
+        if (first != NULL && first->next != NULL)
+          {
+              first = _list_sort_chain(first, cmpFn, &last);
+
+              if (list->flags & LIST_STUB_MODES)
+                {
+                    __atomic_store_n(&(list->head->next), first, 
+                                     __ATOMIC_RELEASE);
+                }
+              else
+                {
+                    list->head = first;
+                }
+              list->tail = last;
+
+              // The back links are rebuilt in a single pass
+              if (list->flags & LIST_DOUBLY_LINKED)
+                {
+                    for (iterator = first; iterator != NULL; 
+                         iterator = iterator->next)
+                      {
+                          NODE_PREV(iterator) = prev;
+                          prev = iterator;
+                      }
+                }
+          }
+    _list_unlock_all(list);
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to insert an element before the first element 
+ * greater than it. It must be called with the locks of both ends taken.
+ * 
+ * @param list Linked list.
+ * @param cmpFn Pointer to the comparison function.
+ * @param data Pointer to the variable which value will be inserted.
+ * 
+ * @return 1 if the list is full, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_list_insert_sorted(list_t* list, 
+                    int (*cmpFn)(const void* data, const void* key), 
+                    const void* data)
+{
+    node_t* prev = _list_node_before(list, 0);
+    node_t* iterator = _list_first(list);
+
+    if (list->flags & LIST_STUB_MODES)
+      {
+          if (_list_reserve(list) != 0)
+            {
+                return 1;
+            }
+      }
+    else if (LIST_IS_FULL(list))
+      {
+          return 1;
+      }
+    else
+      {
+          COUNT_ADD(list, 1);
+      }
+
+    FINGER_RESET(list);
+
+    // Equal elements are skipped so they keep the order of insertion
+    while (iterator != NULL && cmpFn(iterator->data, data) <= 0)
+      {
+          prev = iterator;
+          iterator = NODE_NEXT(iterator);
+      }
+
+    _list_link_after(list, prev, create_node(list, data));
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to insert an element keeping the list sorted, 
+ * before the first element greater than it. If the list is bounded and 
+ * full it fails without waiting nor dropping elements. It is not available
+ * in a LIST_MPSC list.
+ * 
+ * @param list Linked list, sorted with the same comparison function.
+ * @param cmpFn Pointer to the comparison function, as in list_sort.
+ * @param data Pointer to the variable which value will be inserted.
+ * 
+ * @return 1 if the list is full or a LIST_MPSC list, 0 otherwise.
+ * 
+ * \b Example:
+ * @code
+ *      uint8_t error = list_insert_sorted(&list, comparePriority, 
+ *                                         (void *) &task);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+list_insert_sorted(list_t* list, 
+                   int (*cmpFn)(const void* data, const void* key), 
+                   const void* data)
+{
+    uint8_t retval;
+
+    if (list->flags & LIST_MPSC)
+      {
+          return 1;
+      }
+
+    _list_lock_all(list);
+        retval = _list_insert_sorted(list, cmpFn, data);
+    _list_unlock_all(list);
+
+    if (retval == 0)
+      {
+          STATS_PUSHED(list, 1);
+          _list_signal(list, &(list->numPopWaiters), &(list->notEmpty), 1);
+      }
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to start iterating over the elements of the list 
+ * from the front. The list is locked for reading until list_iter_end is 
+ * called, so the list can't be modified by the same thread in the meantime.
+ * 
+ * @param list Linked list.
+ * @param iter Iterator to be initialized.
+ * 
+ * @return None.
+ * 
+ * \b Example:
+ * @code
+ *      list_iter_t iter;
+ *
+ *      list_iter_begin(&list, &iter);
+ *      while (list_iter_get(&iter, (void *) &data) == 0)
+ *        {
+ *            process(data);
+ *            list_iter_next(&iter);
+ *        }
+ *      list_iter_end(&iter);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+list_iter_begin(list_t* list, list_iter_t* iter)
+{
+    _list_read_lock(list);
+
+    iter->list = list;
+    iter->node = _list_first(list);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to get the value of the element at the position of 
+ * the iterator.
+ * 
+ * @param iter Iterator.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element.
+ * 
+ * @return 1 if the iterator is past the end of the list, 0 otherwise.
+ * 
+ * \b Example:
+ * @code
+ *      uint8_t error = list_iter_get(&iter, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+list_iter_get(list_iter_t* iter, void* data)
+{
+    if (iter->node == NULL)
+      {
+          return 1;
+      }
+
+    memcpy(data, iter->node->data, iter->list->dataSize);
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to move the iterator to the next element.
+ * 
+ * @param iter Iterator.
+ * 
+ * @return 1 if the iterator is past the end of the list, 0 otherwise.
+ * 
+ * \b Example:
+ * @code
+ *      uint8_t end = list_iter_next(&iter);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+list_iter_next(list_iter_t* iter)
+{
+    if (iter->node != NULL)
+      {
+          iter->node = NODE_NEXT(iter->node);
+      }
+
+    return (iter->node == NULL);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to finish an iteration started by list_iter_begin,
+ * unlocking the list.
+ * 
+ * @param iter Iterator.
+ * 
+ * @return None.
+ * 
+ * \b Example:
+ * @code
+ *      list_iter_end(&iter);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+list_iter_end(list_iter_t* iter)
+{
+    _list_unlock(iter->list);
+    iter->node = NULL;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to print the values of the list.
+ * 
+ * @param list Linked list.
+ * @param printFn Pointer to the function used to print the elements.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void 
+_list_print(list_t* list, void (*printFn)(const void *data))
+{
+    node_t* iterator = _list_first(list);
+
+    while (iterator != NULL)
+      {
+          printFn(iterator->data);
+          iterator = NODE_NEXT(iterator);
+      }
+
+    printf("\n");
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to print the values of the list.
+ * 
+ * @param list Linked list.
+ * @param printFn Pointer to the function used to print the elements.
+ * 
+ * @return None.
+ * 
+ * \b Example:
+ * @code
+ *      list_print(&list, printInt);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+list_print(list_t* list, void (*printFn)(const void* data))
+{
+    _list_read_lock(list);
+        _list_print(list, printFn);
+    _list_unlock(list);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to iterate over the elements of the list.
+ * 
+ * @param list Linked list.
+ * @param eachFn Pointer to the function that will be executed on each element.
+ * @param arg Argument passed to eachFn.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void 
+_list_for_each(list_t* list, 
+               void (*eachFn)(const void* data, void* arg), 
+               void* arg)
+{
+    node_t* iterator = _list_first(list);
+
+    while (iterator != NULL)
+      {
+          eachFn(iterator->data, arg);
+          iterator = NODE_NEXT(iterator);
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to iterate over the elements of the list.
+ * 
+ * @param list Linked list.
+ * @param eachFn Pointer to the function that will be executed on each element.
+ * @param arg Argument passed to eachFn.
+ * 
+ * @return None.
+ * 
+ * \b Example:
+ * @code
+ *      list_for_each(list, functionPtr, (void *) &arg);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+list_for_each(list_t* list, 
+              void (*eachFn)(const void* data, void* arg), 
+              void* arg)
+{
+    _list_read_lock(list);
+        _list_for_each(list, eachFn, arg);
+    _list_unlock(list);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to split the list in consecutive segments of about 
+ * the same length, one per thread, walking it once. It must be called with 
+ * the lock taken.
+ * 
+ * @param list Linked list.
+ * @param tasks Array where the segments are stored, with room for 
+ *              numThreads tasks.
+ * @param numThreads Maximum number of segments.
+ * 
+ * @return Number of segments, 0 if the list is empty.
+ *
+ */
+/*****************************************************************************/
+static size_t
+_list_partition(list_t* list, struct list_task_t* tasks, size_t numThreads)
+{
+    node_t* iterator = _list_first(list);
+    size_t numElements = list->numElements;
+    size_t segmentLength;
+    size_t numTasks = 0;
+    size_t i = 0;
+
+    // Short lists are split in fewer segments
+    if (numElements / LIST_PARALLEL_MIN_SEGMENT < numThreads)
+      {
+          numThreads = numElements / LIST_PARALLEL_MIN_SEGMENT;
+      }
+    if (numThreads == 0)
+      {
+          numThreads = 1;
+      }
+    segmentLength = (numElements + numThreads - 1) / numThreads;
+    if (segmentLength == 0)
+      {
+          segmentLength = 1;
+      }
+
+    // The producers of a MPSC list may still be linking nodes, only the ones
+    // reached by this walk are processed
+    while (iterator != NULL)
+      {
+          if (i % segmentLength == 0 && numTasks < numThreads)
+            {
+                tasks[numTasks].first = iterator;
+                tasks[numTasks].count = 0;
+                numTasks++;
+            }
+
+          tasks[numTasks - 1].count++;
+          iterator = NODE_NEXT(iterator);
+          i++;
+      }
+
+    return numTasks;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to call the function of a task for every element of
+ * its segment.
+ * 
+ * @param task Task to be run.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_run_task(struct list_task_t* task)
+{
+    node_t* iterator = task->first;
+    size_t i;
+
+    for (i = 0; i < task->count; i++)
+      {
+          task->eachFn(iterator->data, task->arg);
+          iterator = NODE_NEXT(iterator);
+      }
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is the body of the threads of the worker pool. They wait 
+ * for tasks and run them until the process ends.
+ * 
+ * @param arg Unused.
+ * 
+ * @return Never returns.
+ *
+ */
+/*****************************************************************************/
+static void*
+_list_worker(void* arg)
+{
+    struct list_task_t* task;
+
+    (void) arg;
+
+    pthread_mutex_lock(&(workers.lock));
+    for (;;)
+      {
+          while (workers.nextTask >= workers.numTasks)
+            {
+                pthread_cond_wait(&(workers.wake), &(workers.lock));
+            }
+
+          task = &(workers.tasks[workers.nextTask++]);
+          pthread_mutex_unlock(&(workers.lock));
+
+          _list_run_task(task);
+
+          pthread_mutex_lock(&(workers.lock));
+          if (--workers.numPending == 0)
+            {
+                pthread_cond_signal(&(workers.done));
+            }
+      }
+
+    return NULL;
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * @internal
+ * 
+ * \b Description:
+ * 
+ * This function is used to run tasks on the worker pool and wait for all of
+ * them to finish. The calling thread runs tasks too, so numTasks - 1 
+ * workers are created if the pool has fewer.
+ * 
+ * @param tasks Tasks to be run.
+ * @param numTasks Number of tasks.
+ * 
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_list_run_tasks(struct list_task_t* tasks, size_t numTasks)
+{
+    struct list_task_t* task;
+    pthread_attr_t attr;
+    pthread_t thread;
+
+    if (numTasks == 1)
+      {
+          _list_run_task(&tasks[0]);
+          return;
+      }
+
+    pthread_mutex_lock(&(workers.jobLock));
+        pthread_mutex_lock(&(workers.lock));
+            if (workers.numThreads < numTasks - 1)
+              {
+                  pthread_attr_init(&attr);
+                  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+                  while (workers.numThreads < numTasks - 1 &&
+                         pthread_create(&thread, &attr, _list_worker, 
+                                        NULL) == 0)
+                    {
+                        workers.numThreads++;
+                    }
+                  pthread_attr_destroy(&attr);
+              }
+
+            workers.tasks = tasks;
+            workers.numTasks = numTasks;
+            workers.nextTask = 0;
+            workers.numPending = numTasks;
+            pthread_cond_broadcast(&(workers.wake));
+
+            // Take tasks like a worker until there are none left
+            while (workers.nextTask < workers.numTasks)
+              {
+                  task = &(workers.tasks[workers.nextTask++]);
+                  pthread_mutex_unlock(&(workers.lock));
+
+                  _list_run_task(task);
+
+                  pthread_mutex_lock(&(workers.lock));
+                  workers.numPending--;
+              }
+
+            while (workers.numPending > 0)
+              {
+                  pthread_cond_wait(&(workers.done), &(workers.lock));
+              }
+
+            workers.tasks = NULL;
+            workers.numTasks = 0;
+            workers.nextTask = 0;
+        pthread_mutex_unlock(&(workers.lock));
+    pthread_mutex_unlock(&(workers.jobLock));
 }
 
 /*****************************************************************************/
 /*!
+ * 
+ * @internal
  * 
  * \b Description:
  * 
- * This function is used to get the node at the end of the list.
+ * This function is used to iterate over the elements of the list from the 
+ * tail to the head.
  * 
  * @param list Linked list.
- * @param data Pointer to the variable to which will be copied the value of the
- *             node at the end of the list.
- * 
- * @return 1 if there are no elements, 0 otherwise.
+ * @param eachFn Pointer to the function that will be executed on each element.
+ * @param arg Argument passed to eachFn.
  * 
- * \b Example:
- * @code
- *      uint8_t error = list_pop(&list, (void *) &data);
- * @endcode
+ * @return None.
  *
  */
 /*****************************************************************************/
-uint8_t 
-list_pop(list_t* list, void* data)
+static void 
+_list_for_each_reverse(list_t* list, 
+                       void (*eachFn)(const void* data, void* arg), 
+                       void* arg)
 {
-    uint8_t retval;
+    node_t* iterator = list->tail;
 
-    pthread_mutex_lock(&(list->lock));
-        retval = _list_pop(list, data);
-    pthread_mutex_unlock(&(list->lock));
-
-    return retval;
+    while (iterator != NULL)
+      {
+          eachFn(iterator->data, arg);
+          iterator = NODE_PREV(iterator);
+      }
 }
 
 /*****************************************************************************/
 /*!
- * 
- * @internal
  * 
  * \b Description:
  * 
- * This function is used to get the node at the front of the list.
+ * This function is used to iterate over the elements of the list from the 
+ * tail to the head. The list must be initialized with the LIST_DOUBLY_LINKED 
+ * flag.
  * 
  * @param list Linked list.
- * @param data Pointer to the variable to which will be copied the value of the
- *             node at the front of the list.
+ * @param eachFn Pointer to the function that will be executed on each element.
+ * @param arg Argument passed to eachFn.
  * 
- * @return 1 if there are no elements, 0 otherwise.
+ * @return 1 if the list is not doubly linked, 0 otherwise.
  * 
+ * \b Example:
+ * @code
+ *      uint8_t error = list_for_each_reverse(list, functionPtr, (void *) &arg);
+ * @endcode
+ *
  */
 /*****************************************************************************/
-static uint8_t
-_list_pop_front(list_t* list, void* data)
+uint8_t
+list_for_each_reverse(list_t* list, 
+                      void (*eachFn)(const void* data, void* arg), 
+                      void* arg)
 {
-    node_t* temp;
-
-    // If the linked list is empty, return error
-    if (list->numElements == 0)
+    if (!(list->flags & LIST_DOUBLY_LINKED))
       {
           return 1;
       }
-    else if (list->numElements == 1)
-      {
-          memcpy(data, list->head->data, list->dataSize);
-          free_node(list->head);
-          list->head = NULL;
-          list->tail = NULL;
-          list->numElements--;
-
-          return 0;
-      }
 
-    memcpy(data, list->head->data, list->dataSize);
-    temp = list->head;
-    list->head = list->head->next;
-    free_node(temp);
-    list->numElements--;
+    _list_read_lock(list);
+        _list_for_each_reverse(list, eachFn, arg);
+    _list_unlock(list);
 
     return 0;
 }
 
 /*****************************************************************************/
 /*!
+ * 
+ * @internal
  * 
  * \b Description:
  * 
- * This function is used to get the node at the front of the list.
+ * This function is used to get the number of elements in the list.
  * 
  * @param list Linked list.
- * @param data Pointer to the variable to which will be copied the value of the
- *             node at the front of the list.
  * 
- * @return 1 if there are no elements, 0 otherwise.
+ * @return Number of elements in the list.
+ *
+ */
+/*****************************************************************************/
+static size_t
+_list_size(list_t* list)
+{
+    return atomic_load_explicit(&(list->numElements), memory_order_relaxed);
+}
+
+/*****************************************************************************/
+/*!
+ * 
+ * \b Description:
+ * 
+ * This function is used to call a function for every element of the list 
+ * from several threads. The list is split in one segment per thread and the
+ * segments run on a worker pool, the calling thread included. eachFn is 
+ * called concurrently and in no particular order, and it must not call the
+ * parallel methods. The lists shorter than LIST_PARALLEL_MIN_SEGMENT 
+ * elements per thread use fewer threads.
+ * 
+ * @param list Linked list.
+ * @param eachFn Pointer to the function that will be executed on each element.
+ * @param arg Argument passed to eachFn.
+ * @param numThreads Number of threads, up to LIST_PARALLEL_MAX_THREADS.
+ * 
+ * @return None.
  * 
  * \b Example:
  * @code
- *      uint8_t error = list_pop_front(&list, (void *) &data);
+ *      list_parallel_for_each(&list, functionPtr, (void *) &arg, 4);
  * @endcode
  *
  */
 /*****************************************************************************/
-uint8_t
-list_pop_front(list_t* list, void* data)
+void
+list_parallel_for_each(list_t* list, 
+                       void (*eachFn)(const void* data, void* arg), 
+                       void* arg, 
+                       uint32_t numThreads)
 {
-    uint8_t retval;
+    struct list_task_t tasks[LIST_PARALLEL_MAX_THREADS];
+    size_t numTasks;
+    size_t i;
 
-    pthread_mutex_lock(&(list->lock));
-        retval = _list_pop_front(list, data);
-    pthread_mutex_unlock(&(list->lock));
+    if (numThreads > LIST_PARALLEL_MAX_THREADS)
+      {
+          numThreads = LIST_PARALLEL_MAX_THREADS;
+      }
 
-    return retval;
+    _list_read_lock(list);
+        numTasks = _list_partition(list, tasks, numThreads);
+        for (i = 0; i < numTasks; i++)
+          {
+              tasks[i].eachFn = eachFn;
+              tasks[i].arg = arg;
+          }
+
+        if (numTasks > 0)
+          {
+              _list_run_tasks(tasks, numTasks);
+          }
+    _list_unlock(list);
 }
 
 /*****************************************************************************/
 /*!
- * 
- * @internal
  * 
  * \b Description:
  * 
- * This function is used to get the value of a node at a given index.
- * It doesn't delete the node.
+ * This function is used to reduce the elements of the list to a single 
+ * value from several threads. Every thread starts with a copy of identity 
+ * as its accumulator and folds the elements of its segment into it with 
+ * mapFn. The accumulators are then combined in the order of the segments 
+ * with combineFn, so combineFn needs to be associative but not commutative.
+ * The same restrictions as list_parallel_for_each() apply to mapFn.
  * 
  * @param list Linked list.
- * @param index Index of the node.
- * @param data Pointer to the variable to which will be copied the value of the
- *             node at the given index.
+ * @param mapFn Pointer to the function that folds an element into an 
+ *              accumulator.
+ * @param combineFn Pointer to the function that folds the accumulator other
+ *                  into acc.
+ * @param identity Pointer to the initial value of the accumulators.
+ * @param out Pointer to the variable where the result is written. It is 
+ *            identity if the list is empty.
+ * @param accSize Size of the accumulators.
+ * @param numThreads Number of threads, up to LIST_PARALLEL_MAX_THREADS.
  * 
- * @return 1 if the given index is out of limits, 0 otherwise.
+ * @return 1 if the memory of the accumulators could not be allocated, 0 
+ *         otherwise.
+ * 
+ * \b Example:
+ * @code
+ *      uint64_t zero = 0;
+ *      uint64_t total;
+ *      list_parallel_reduce(&list, addElement, addTotals, (void *) &zero, 
+ *                           (void *) &total, sizeof(uint64_t), 4);
+ * @endcode
  *
  */
 /*****************************************************************************/
-static uint8_t
-_list_get_by_index(list_t* list, uint8_t index, void* data)
+uint8_t
+list_parallel_reduce(list_t* list, 
+                     void (*mapFn)(const void* data, void* acc), 
+                     void (*combineFn)(void* acc, const void* other), 
+                     const void* identity, 
+                     void* out, 
+                     size_t accSize, 
+                     uint32_t numThreads)
 {
-    int i;
-    node_t* iterator = list->head;
+    struct list_task_t tasks[LIST_PARALLEL_MAX_THREADS];
+    unsigned char* accs;
+    size_t stride;
+    size_t numTasks;
+    size_t i;
 
-    // Check if index is between limits of linked list
-    if(index > list->numElements-1)
+    if (numThreads > LIST_PARALLEL_MAX_THREADS)
+      {
+          numThreads = LIST_PARALLEL_MAX_THREADS;
+      }
+
+    // One accumulator per thread, each in its own cache line
+    stride = (accSize + 63) & ~(size_t) 63;
+    accs = (unsigned char *) malloc(((numThreads > 0) ? numThreads : 1) * 
+                                    stride);
+    if (accs == NULL)
       {
           return 1;
       }
 
-    for(i = 0; i < index; i++)
+    memcpy(out, identity, accSize);
+
+    _list_read_lock(list);
+        numTasks = _list_partition(list, tasks, numThreads);
+        for (i = 0; i < numTasks; i++)
+          {
+              memcpy(accs + i * stride, identity, accSize);
+              tasks[i].eachFn = mapFn;
+              tasks[i].arg = accs + i * stride;
+          }
+
+        if (numTasks > 0)
+          {
+              _list_run_tasks(tasks, numTasks);
+          }
+    _list_unlock(list);
+
+    for (i = 0; i < numTasks; i++)
       {
-          iterator = iterator->next;
+          combineFn(out, accs + i * stride);
       }
 
-    memcpy(data, iterator->data, list->dataSize);
+    free(accs);
+
     return 0;
 }
 
@@ -607,63 +5475,78 @@ _list_get_by_index(list_t* list, uint8_t index, void* data)
  * 
  * \b Description:
  * 
- * This function is used to get the value of a node at a given index.
- * It doesn't delete the node.
+ * This function is used to get the number of elements in the list. It 
+ * doesn't take the lock, so it can be polled without contending with the 
+ * producers. In a LIST_MPSC list the count includes the elements that are 
+ * being pushed.
  * 
  * @param list Linked list.
- * @param index Index of the node.
- * @param data Pointer to the variable to which will be copied the value of the
- *             node at the given index.
  * 
- * @return 1 if the given index is out of limits, 0 otherwise.
+ * @return Number of elements in the list.
  * 
  * \b Example:
  * @code
- *      uint8_t error = list_get_by_index(&list, index, (void *) &data);
+ *      size_t listSize = list_size(&list);
  * @endcode
  *
  */
 /*****************************************************************************/
-uint8_t 
-list_get_by_index(list_t* list, uint8_t index, void* data)
+size_t
+list_size(list_t* list)
 {
-    uint8_t retval;
-
-    pthread_mutex_lock(&(list->lock));
-        retval = _list_get_by_index(list, index, data);
-    pthread_mutex_unlock(&(list->lock));
-
-    return retval;
+    // The count is atomic, so it is read without taking the lock
+    return _list_size(list);
 }
 
 /*****************************************************************************/
 /*!
- * 
- * @internal
  * 
  * \b Description:
  * 
- * This function is used to print the values of the list.
+ * This function is used to get information about the node pool of the list.
+ * If the list doesn't use a node pool all the fields are 0.
  * 
  * @param list Linked list.
- * @param printFn Pointer to the function used to print the elements.
+ * @param info Pointer to the structure to which will be copied the 
+ *             information of the node pool.
  * 
  * @return None.
+ * 
+ * \b Example:
+ * @code
+ *      list_pool_info_t info;
+ *      list_pool_info(&list, &info);
+ * @endcode
  *
  */
 /*****************************************************************************/
-static void 
-_list_print(list_t* list, void (*printFn)(const void *data))
+void
+list_pool_info(list_t* list, list_pool_info_t* info)
 {
-    node_t* iterator = list->head;
+    node_t* iterator = NULL;
+    size_t numFreeNodes = 0;
 
-    while (iterator != NULL)
-      {
-          printFn(iterator->data);
-          iterator = iterator->next;
-      }
+    _list_read_lock(list);
+        for (iterator = list->pool.freeNodes; 
+             iterator != NULL; 
+             iterator = iterator->next)
+          {
+              numFreeNodes++;
+          }
 
-    printf("\n");
+        if (list->pool.chunks != NULL)
+          {
+              numFreeNodes += list->pool.nodesPerChunk - list->pool.numCarved;
+          }
+
+        info->nodesPerChunk = list->pool.nodesPerChunk;
+        info->numChunks = list->pool.numChunks;
+        info->numNodes = list->pool.numChunks * list->pool.nodesPerChunk;
+        info->numFreeNodes = numFreeNodes;
+        info->numBytes = list->pool.numChunks * 
+                         (sizeof(struct list_chunk_t) + 
+                          list->pool.nodesPerChunk * list->pool.nodeSize);
+    _list_unlock(list);
 }
 
 /*****************************************************************************/
@@ -671,57 +5554,84 @@ _list_print(list_t* list, void (*printFn)(const void *data))
  * 
  * \b Description:
  * 
- * This function is used to print the values of the list.
+ * This function is used to get the statistics of the list. It is only 
+ * available when the library is built with LIST_STATS set to 1, otherwise 
+ * all the fields are 0. The counters are read one by one while the list may
+ * be in use, so they are not a consistent snapshot.
  * 
  * @param list Linked list.
- * @param printFn Pointer to the function used to print the elements.
+ * @param stats Pointer to the structure to which will be copied the 
+ *              statistics of the list.
  * 
- * @return None.
+ * @return 1 if the library is built without LIST_STATS, 0 otherwise.
  * 
  * \b Example:
  * @code
- *      list_print(&list, printInt);
+ *      list_stats_t stats;
+ *      list_get_stats(&list, &stats);
  * @endcode
  *
  */
 /*****************************************************************************/
-void
-list_print(list_t* list, void (*printFn)(const void* data))
+uint8_t
+list_get_stats(list_t* list, list_stats_t* stats)
 {
-    pthread_mutex_lock(&(list->lock));
-        _list_print(list, printFn);
-    pthread_mutex_unlock(&(list->lock));
+    memset(stats, 0, sizeof(list_stats_t));
+
+#if LIST_STATS
+    stats->pushes = atomic_load(&(list->stats.pushes));
+    stats->pops = atomic_load(&(list->stats.pops));
+    stats->failedPops = atomic_load(&(list->stats.failedPops));
+    stats->lockAcquisitions = atomic_load(&(list->stats.lockAcquisitions));
+    stats->contendedAcquisitions = 
+        atomic_load(&(list->stats.contendedAcquisitions));
+    stats->lockHoldNs = atomic_load(&(list->stats.lockHoldNs));
+    stats->maxLockHoldNs = atomic_load(&(list->stats.maxLockHoldNs));
+    stats->highWaterMark = atomic_load(&(list->stats.highWaterMark));
+
+    return 0;
+#else
+    (void) list;
+
+    return 1;
+#endif
 }
 
 /*****************************************************************************/
 /*!
- * 
- * @internal
  * 
  * \b Description:
  * 
- * This function is used to iterate over the elements of the list.
+ * This function is used to set the statistics of the list back to 0. The 
+ * high-water mark starts again from the current number of elements.
  * 
  * @param list Linked list.
- * @param eachFn Pointer to the function that will be executed on each element.
- * @param arg Argument passed to eachFn.
  * 
  * @return None.
+ * 
+ * \b Example:
+ * @code
+ *      list_reset_stats(&list);
+ * @endcode
  *
  */
 /*****************************************************************************/
-static void 
-_list_for_each(list_t* list, 
-               void (*eachFn)(const void* data, void* arg), 
-               void* arg)
+void
+list_reset_stats(list_t* list)
 {
-    node_t* iterator = list->head;
-
-    while (iterator != NULL)
-      {
-          eachFn(iterator->data, arg);
-          iterator = iterator->next;
-      }
+#if LIST_STATS
+    atomic_store(&(list->stats.pushes), 0);
+    atomic_store(&(list->stats.pops), 0);
+    atomic_store(&(list->stats.failedPops), 0);
+    atomic_store(&(list->stats.lockAcquisitions), 0);
+    atomic_store(&(list->stats.contendedAcquisitions), 0);
+    atomic_store(&(list->stats.lockHoldNs), 0);
+    atomic_store(&(list->stats.maxLockHoldNs), 0);
+    atomic_store(&(list->stats.highWaterMark), 
+                 atomic_load(&(list->numElements)));
+#else
+    (void) list;
+#endif
 }
 
 /*****************************************************************************/
@@ -729,54 +5639,106 @@ _list_for_each(list_t* list,
  * 
  * \b Description:
  * 
- * This function is used to iterate over the elements of the list.
+ * This function is used to get a summary of the time the elements spent in 
+ * a LIST_DWELL_TIME list, from their push until their pop. It may be called
+ * while the list is in use, the elements popped meanwhile may or may not be
+ * included.
  * 
  * @param list Linked list.
- * @param eachFn Pointer to the function that will be executed on each element.
- * @param arg Argument passed to eachFn.
+ * @param stats Pointer to the structure to which will be copied the summary
+ *              of the dwell times.
  * 
- * @return None.
+ * @return 1 if the list doesn't have the LIST_DWELL_TIME flag, 0 otherwise.
  * 
  * \b Example:
  * @code
- *      list_for_each(list, functionPtr, (void *) &arg);
+ *      list_dwell_stats_t stats;
+ *      list_get_dwell(&list, &stats);
+ *      printf("p99: %llu ns\n", (unsigned long long) stats.p99Ns);
  * @endcode
  *
  */
 /*****************************************************************************/
-void
-list_for_each(list_t* list, 
-              void (*eachFn)(const void* data, void* arg), 
-              void* arg)
+uint8_t
+list_get_dwell(list_t* list, list_dwell_stats_t* stats)
 {
-    pthread_mutex_lock(&(list->lock));
-        _list_for_each(list, eachFn, arg);
-    pthread_mutex_unlock(&(list->lock));
+    list_dwell_t* dwell = list->dwell;
+    uint64_t count = 0;
+    size_t i;
+
+    memset(stats, 0, sizeof(list_dwell_stats_t));
+
+    if (dwell == NULL)
+      {
+          return 1;
+      }
+
+    // The number of values is the sum of the buckets, so the percentiles 
+    // are consistent with the buckets read even while other threads pop
+    for (i = 0; i < DWELL_BUCKETS; i++)
+      {
+          count += atomic_load_explicit(&(dwell->buckets[i]), 
+                                        memory_order_relaxed);
+      }
+
+    if (count == 0)
+      {
+          return 0;
+      }
+
+    stats->count = count;
+    stats->meanNs = atomic_load(&(dwell->totalNs)) / count;
+    stats->maxNs = atomic_load(&(dwell->maxNs));
+    stats->p50Ns = _list_dwell_percentile(dwell, count, 500);
+    stats->p99Ns = _list_dwell_percentile(dwell, count, 990);
+    stats->p999Ns = _list_dwell_percentile(dwell, count, 999);
+
+    // The bucket bounds can be above the largest value recorded
+    stats->p50Ns = (stats->p50Ns < stats->maxNs) ? stats->p50Ns : stats->maxNs;
+    stats->p99Ns = (stats->p99Ns < stats->maxNs) ? stats->p99Ns : stats->maxNs;
+    stats->p999Ns = (stats->p999Ns < stats->maxNs) ? stats->p999Ns : 
+                                                      stats->maxNs;
+
+    return 0;
 }
 
 /*****************************************************************************/
 /*!
- * 
- * @internal
  * 
  * \b Description:
  * 
- * This function is used to get the number of elements in the list.
+ * This function is used to clear the dwell times recorded by a 
+ * LIST_DWELL_TIME list. The elements still in the list keep their push time.
  * 
  * @param list Linked list.
  * 
- * @return Number of elements in the list.
+ * @return None.
+ * 
+ * \b Example:
+ * @code
+ *      list_reset_dwell(&list);
+ * @endcode
  *
  */
 /*****************************************************************************/
-static uint8_t
-_list_size(list_t* list)
+void
+list_reset_dwell(list_t* list)
 {
-    uint8_t retval;
+    size_t i;
 
-    retval = list->numElements;
+    if (list->dwell == NULL)
+      {
+          return;
+      }
 
-    return retval;
+    atomic_store(&(list->dwell->totalNs), 0);
+    atomic_store(&(list->dwell->maxNs), 0);
+
+    for (i = 0; i < DWELL_BUCKETS; i++)
+      {
+          atomic_store_explicit(&(list->dwell->buckets[i]), 0, 
+                                memory_order_relaxed);
+      }
 }
 
 /*****************************************************************************/
@@ -784,29 +5746,39 @@ _list_size(list_t* list)
  * 
  * \b Description:
  * 
- * This function is used to get the number of elements in the list.
+ * This function is used to print the summary of the dwell times of a 
+ * LIST_DWELL_TIME list, see list_get_dwell().
  * 
  * @param list Linked list.
  * 
- * @return Number of elements in the list.
+ * @return None.
  * 
  * \b Example:
  * @code
- *      uint8_t listSize = list_size(&list);
+ *      list_print_dwell(&list);
  * @endcode
  *
  */
 /*****************************************************************************/
-uint8_t
-list_size(list_t* list)
+void
+list_print_dwell(list_t* list)
 {
-    uint8_t retval;
+    list_dwell_stats_t stats;
 
-    pthread_mutex_lock(&(list->lock));
-        retval = _list_size(list);
-    pthread_mutex_unlock(&(list->lock));
+    if (list_get_dwell(list, &stats) != 0)
+      {
+          printf("Dwell time not recorded\n");
+          return;
+      }
 
-    return retval;
+    printf("Dwell time (ns) :: count %llu :: mean %llu :: p50 %llu :: "
+           "p99 %llu :: p999 %llu :: max %llu\n",
+           (unsigned long long) stats.count, 
+           (unsigned long long) stats.meanNs,
+           (unsigned long long) stats.p50Ns, 
+           (unsigned long long) stats.p99Ns,
+           (unsigned long long) stats.p999Ns, 
+           (unsigned long long) stats.maxNs);
 }
 
 /*****************************************************************************/
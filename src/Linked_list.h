@@ -23,17 +23,78 @@
 ******************************************************************************/
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <pthread.h>
+#include <stdatomic.h>
 
 /******************************************************************************
 * Preprocessor Constants
 ******************************************************************************/
+/**
+ * Mode flag used to link every node to its previous node. It makes list_pop
+ * O(1) and enables list_for_each_reverse.
+ */
+#define LIST_DOUBLY_LINKED      (1u << 0)
+/**
+ * Mode flag used to turn the list into a lock-free multi-producer single-
+ * consumer queue. list_push doesn't take the lock, the rest of the methods
+ * must only be called from the consumer side. It can't be combined with 
+ * LIST_DOUBLY_LINKED nor with a node pool.
+ */
+#define LIST_MPSC               (1u << 1)
+/**
+ * Mode flag used to protect the head and the tail of the list with separate
+ * locks, so list_push and list_pop_front don't contend with each other. It 
+ * can't be combined with LIST_MPSC, LIST_DOUBLY_LINKED nor with a node pool.
+ */
+#define LIST_TWO_LOCK           (1u << 2)
+/**
+ * Mode flag used to protect the list with a reader-writer lock, so the 
+ * methods that only read the list don't block each other. The callbacks of 
+ * list_for_each and list_for_each_reverse must not modify the data then.
+ */
+#define LIST_RWLOCK             (1u << 3)
+/**
+ * Mode flag used to stamp every node with the time it is created and record
+ * the time each element spent in the list when it is popped, read with 
+ * list_get_dwell. It adds 8 bytes to every node.
+ */
+#define LIST_DWELL_TIME         (1u << 4)
+/**
+ * Timeout used to wait without limit in the blocking methods
+ */
+#define LIST_WAIT_FOREVER       UINT32_MAX
+/**
+ * Overflow policy of a bounded list: the push methods wait for room
+ */
+#define LIST_OVERFLOW_BLOCK         0
+/**
+ * Overflow policy of a bounded list: the push methods drop the element at 
+ * the opposite end of the list to make room (the oldest one for list_push)
+ */
+#define LIST_OVERFLOW_DROP_OLDEST   1
 
 
 /******************************************************************************
 * Configuration Constants
 ******************************************************************************/
+/**
+ * Set to 1 (e.g. -DLIST_STATS=1) to record the statistics of every list, 
+ * which are read with list_get_stats. When it is 0 the counters are not part
+ * of list_t and the methods don't touch them. It must have the same value in
+ * every file that includes this header.
+ */
+#ifndef LIST_STATS
+#define LIST_STATS              0
+#endif
+/**
+ * Maximum number of threads used by list_parallel_for_each and 
+ * list_parallel_reduce
+ */
+#ifndef LIST_PARALLEL_MAX_THREADS
+#define LIST_PARALLEL_MAX_THREADS   8
+#endif
 
 
 /******************************************************************************
@@ -52,22 +113,198 @@ typedef struct list_t list_t;
  * Node type definition
  */
 typedef struct node_t node_t;
+/**
+ * Node pool chunk type definition
+ */
+typedef struct list_chunk_t list_chunk_t;
+/**
+ * Node pool type definition
+ */
+typedef struct list_pool_t list_pool_t;
+/**
+ * Node pool information type definition
+ */
+typedef struct list_pool_info_t list_pool_info_t;
+/**
+ * Linked list configuration type definition
+ */
+typedef struct list_config_t list_config_t;
+/**
+ * Linked list iterator type definition
+ */
+typedef struct list_iter_t list_iter_t;
+/**
+ * Linked list statistics type definition
+ */
+typedef struct list_stats_t list_stats_t;
+/**
+ * Linked list statistics counters type definition
+ */
+typedef struct list_counters_t list_counters_t;
+/**
+ * Dwell time histogram type definition
+ */
+typedef struct list_dwell_t list_dwell_t;
+/**
+ * Dwell time summary type definition
+ */
+typedef struct list_dwell_stats_t list_dwell_stats_t;
+
+/*! @brief Node pool structure definition
+ *
+ *  When enabled, nodes are carved from chunks of nodesPerChunk nodes and 
+ *  popped nodes are kept in a free list to be reused by the next push. The 
+ *  chunks are only released by list_free() and list_destroy().
+ */
+struct list_pool_t
+{
+    size_t nodesPerChunk;   /**< Nodes per chunk, 0 if the pool is disabled */
+    size_t nodeSize;        /**< Size of a node including its data */
+    size_t numChunks;       /**< Number of chunks allocated */
+    size_t numCarved;       /**< Nodes carved from the newest chunk */
+    list_chunk_t* chunks;   /**< Chunks allocated, newest first */
+    node_t* freeNodes;      /**< Free list of recycled nodes */
+};
+
+/*! @brief Node pool information structure definition */
+struct list_pool_info_t
+{
+    size_t nodesPerChunk;   /**< Nodes per chunk */
+    size_t numChunks;       /**< Number of chunks allocated */
+    size_t numNodes;        /**< Number of nodes the chunks can hold */
+    size_t numFreeNodes;    /**< Nodes available without a new chunk */
+    size_t numBytes;        /**< Bytes allocated by the chunks */
+};
+
+/*! @brief Linked list configuration structure definition
+ *
+ *  A zero initialized configuration gives the same list as list_init().
+ */
+struct list_config_t
+{
+    uint32_t flags;         /**< Bitwise OR of the LIST_* mode flags */
+    size_t nodesPerChunk;   /**< Nodes per chunk of the node pool, 0 if none */
+    size_t capacity;        /**< Maximum number of elements, 0 if unbounded */
+    uint8_t overflowPolicy; /**< LIST_OVERFLOW_* policy of a bounded list */
+};
+
+/*! @brief Linked list statistics structure definition
+ *
+ *  The lock is the mutex or the reader-writer lock of the list, only the 
+ *  head lock in a LIST_TWO_LOCK list. The hold time of the readers of a 
+ *  LIST_RWLOCK list is not measured, as they hold the lock concurrently.
+ */
+struct list_stats_t
+{
+    uint64_t pushes;        /**< Elements added by the push and insert methods */
+    uint64_t pops;          /**< Elements removed by the pop and remove methods */
+    uint64_t failedPops;    /**< Pops that found the list empty */
+    uint64_t lockAcquisitions; /**< Times the lock was taken */
+    uint64_t contendedAcquisitions; /**< Times the lock was busy when taken */
+    uint64_t lockHoldNs;    /**< Total time the lock was held in ns */
+    uint64_t maxLockHoldNs; /**< Longest time the lock was held in ns */
+    size_t highWaterMark;   /**< Largest number of elements in the list */
+};
+
+/*! @brief Dwell time summary structure definition
+ *
+ *  The dwell time of an element is the time between its push and its pop. 
+ *  The percentiles are the upper bound of the bucket of the histogram they 
+ *  fall in, which is at most 1/16 larger than the exact value.
+ */
+struct list_dwell_stats_t
+{
+    uint64_t count;         /**< Number of elements popped */
+    uint64_t meanNs;        /**< Mean dwell time in ns */
+    uint64_t p50Ns;         /**< Median dwell time in ns */
+    uint64_t p99Ns;         /**< 99th percentile of the dwell time in ns */
+    uint64_t p999Ns;        /**< 99.9th percentile of the dwell time in ns */
+    uint64_t maxNs;         /**< Longest dwell time in ns */
+};
+
+#if LIST_STATS
+/*! @brief Linked list statistics counters structure definition
+ *
+ *  The counters are the fields of list_stats_t. They are updated by every 
+ *  thread using the list, so they are atomic. lockedAt is only written while
+ *  the lock is held exclusively.
+ */
+struct list_counters_t
+{
+    atomic_uint_least64_t pushes;
+    atomic_uint_least64_t pops;
+    atomic_uint_least64_t failedPops;
+    atomic_uint_least64_t lockAcquisitions;
+    atomic_uint_least64_t contendedAcquisitions;
+    atomic_uint_least64_t lockHoldNs;
+    atomic_uint_least64_t maxLockHoldNs;
+    atomic_size_t highWaterMark;
+    uint64_t lockedAt;      /**< Time the lock was taken exclusively in ns, 0 
+                                 if it is not */
+};
+#endif
 
 /*! @brief Linked list structure definition */
 struct list_t
 {
-    uint8_t numElements;    /**< Number of elements in the linked list */
+    atomic_size_t numElements; /**< Number of elements in the linked list */
     size_t dataSize;        /**< Size of data of the nodes */
-    node_t* head;           /**< Pointer to the head the linked list */
+    uint32_t flags;         /**< Bitwise OR of the LIST_* mode flags */
+    size_t capacity;        /**< Maximum number of elements, 0 if unbounded */
+    uint8_t overflowPolicy; /**< LIST_OVERFLOW_* policy of a bounded list */
+    node_t* head;           /**< Pointer to the head the linked list. In a 
+                                 LIST_MPSC or LIST_TWO_LOCK list it is a stub
+                                 node that precedes the first element */
     node_t* tail;           /**< Pointer to the tail linked list */
-    pthread_mutex_t lock;   /**< Mutex used to lock the linked list */
+    node_t* finger;         /**< Node of the last index accessed, NULL if 
+                                 unknown. Unused in a LIST_RWLOCK list, 
+                                 whose readers run concurrently */
+    size_t fingerIndex;     /**< Index of the finger node */
+    pthread_mutex_t lock;   /**< Mutex used to lock the linked list, only 
+                                 the head in a LIST_TWO_LOCK list */
+    pthread_rwlock_t rwlock; /**< Lock used instead of the mutex in a 
+                                  LIST_RWLOCK list */
+    pthread_mutex_t tailLock; /**< Mutex used to lock the tail of a 
+                                   LIST_TWO_LOCK list */
+    pthread_mutex_t waitLock; /**< Mutex used by the threads waiting for 
+                                   elements */
+    pthread_cond_t notEmpty;  /**< Condition signalled when an element is 
+                                   pushed or the list is closed */
+    pthread_cond_t notFull;   /**< Condition signalled when an element of a
+                                   bounded list is popped or the list is 
+                                   closed */
+    atomic_size_t numPopWaiters;  /**< Threads waiting for elements */
+    atomic_size_t numPushWaiters; /**< Threads waiting for room */
+    atomic_bool closed;       /**< Set when the list is closed */
+    list_pool_t pool;       /**< Node pool, unused if nodesPerChunk is 0 */
+    list_dwell_t* dwell;    /**< Histogram of the dwell times, NULL unless
+                                 the list is LIST_DWELL_TIME */
+#if LIST_STATS
+    list_counters_t stats;  /**< Statistics read by list_get_stats */
+#endif
 };
 
-/*! @brief Node structure definition */
+/*! @brief Node structure definition
+ *
+ *  The data of the node is stored inline right after the header, so a node
+ *  and its payload are allocated with a single call and share cache lines.
+ *  In a LIST_DOUBLY_LINKED list the pointer to the previous node is stored 
+ *  right before the header, so singly linked lists don't pay for it.
+ */
 struct node_t
 {
-    void* data;     /**< Pointer to the data of the node */
-    node_t* next;   /**< Pointer to the next node */
+    node_t* next;           /**< Pointer to the next node */
+    unsigned char data[];   /**< Data of the node (list_t.dataSize bytes) */
+};
+
+/*! @brief Linked list iterator structure definition
+ *
+ *  The list is locked for reading from list_iter_begin() to list_iter_end().
+ */
+struct list_iter_t
+{
+    list_t* list;           /**< Linked list being iterated */
+    node_t* node;           /**< Current node, NULL past the end */
 };
 
 /******************************************************************************
@@ -79,15 +316,50 @@ struct node_t
 * Function Prototypes
 ******************************************************************************/
 void list_init(list_t* list, size_t dataSize);
+void list_init_pooled(list_t* list, size_t dataSize, size_t nodesPerChunk);
+uint8_t list_init_config(list_t* list, size_t dataSize, const list_config_t* config);
 void list_free(list_t* list);
 void list_destroy(list_t* list);
 void list_push(list_t* list, const void* data);
 void list_push_front(list_t* list, const void* data);
+uint8_t list_try_push(list_t* list, const void* data);
+uint8_t list_push_wait(list_t* list, const void* data, uint32_t timeoutMs);
+size_t list_push_n(list_t* list, const void* array, size_t n);
 uint8_t list_pop(list_t* list, void* data);
 uint8_t list_pop_front(list_t* list, void* data);
-uint8_t list_get_by_index(list_t* list, uint8_t index, void* data);
+size_t list_pop_front_n(list_t* list, void* out, size_t max);
+void* list_pop_front_borrow(list_t* list);
+void list_borrow_release(list_t* list, void* data);
+uint8_t list_splice(list_t* dst, list_t* src);
+uint8_t list_take_all(list_t* list, list_t* out);
+uint8_t list_pop_wait(list_t* list, void* data, uint32_t timeoutMs);
+uint8_t list_pop_front_wait(list_t* list, void* data, uint32_t timeoutMs);
+void list_close(list_t* list);
+uint8_t list_get_by_index(list_t* list, size_t index, void* data);
+uint8_t list_insert_at(list_t* list, size_t index, const void* data);
+uint8_t list_remove_at(list_t* list, size_t index, void* data);
+size_t list_remove_if(list_t* list, uint8_t (*predFn)(const void* data, void* arg), void* arg);
+uint8_t list_find(list_t* list, int (*cmpFn)(const void* data, const void* key), const void* key, void* data);
+uint8_t list_sort(list_t* list, int (*cmpFn)(const void* data, const void* key));
+uint8_t list_insert_sorted(list_t* list, int (*cmpFn)(const void* data, const void* key), const void* data);
+void* list_peek_front(list_t* list);
+void* list_peek_at(list_t* list, size_t index);
+void list_peek_end(list_t* list);
+void list_iter_begin(list_t* list, list_iter_t* iter);
+uint8_t list_iter_get(list_iter_t* iter, void* data);
+uint8_t list_iter_next(list_iter_t* iter);
+void list_iter_end(list_iter_t* iter);
 void list_print(list_t* list, void (*printFn)(const void* data));
 void list_for_each(list_t* list, void (*eachFn)(const void* data, void* arg), void* arg);
-uint8_t list_size(list_t* list);
+void list_parallel_for_each(list_t* list, void (*eachFn)(const void* data, void* arg), void* arg, uint32_t numThreads);
+uint8_t list_parallel_reduce(list_t* list, void (*mapFn)(const void* data, void* acc), void (*combineFn)(void* acc, const void* other), const void* identity, void* out, size_t accSize, uint32_t numThreads);
+uint8_t list_for_each_reverse(list_t* list, void (*eachFn)(const void* data, void* arg), void* arg);
+size_t list_size(list_t* list);
+void list_pool_info(list_t* list, list_pool_info_t* info);
+uint8_t list_get_stats(list_t* list, list_stats_t* stats);
+void list_reset_stats(list_t* list);
+uint8_t list_get_dwell(list_t* list, list_dwell_stats_t* stats);
+void list_reset_dwell(list_t* list);
+void list_print_dwell(list_t* list);
 
 #endif /* LINKED_LIST_H */
@@ -0,0 +1,853 @@
+/******************************************************************************
+* Title                 :   Indexed skip list source file
+* Filename              :   Skip_list.c
+* Author                :   Maximiliano Valencia
+* Origin Date           :   09/02/2019
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   STM32
+* Notes                 :   None
+******************************************************************************/
+/*! @file Skip_list.c
+ *  @brief Indexed skip list implementation
+ *
+ *  To use the indexed skip list implementation, include this header file as
+ *  follows:
+ *  @code
+ *  #include "Skip_list.h"
+ *  @endcode
+ *
+ *  ## Overview ##
+ *  An Indexed Skip List offers the same methods as the Linked List (see
+ *  Linked_list.h) plus insertion and removal at any position. Besides the
+ *  link to the next node, a node has links at higher levels which skip over
+ *  several nodes, and every link stores how many positions it skips. Walking
+ *  from the highest level down to the lowest one reaches any position in
+ *  O(log n) steps, so skiplist_get_by_index, skiplist_insert_at and
+ *  skiplist_remove_at don't walk the whole list while holding the lock.
+ *
+ *  The number of levels of a node is chosen randomly when it is created, a
+ *  node reaches the next level with a probability of 1/4.
+ *
+ *  ## Usage ##
+ *
+ *  The following code example initializes the indexed skip list, writes to
+ *  it and then gets elements from it.
+ *
+ *  @code
+ *      int data;
+ *      skiplist_t sl;
+ *
+ *      skiplist_init(&sl, sizeof(int));
+ *
+ *      data = 4;
+ *      skiplist_push(&sl, (void *) &data);
+ *      data = 17;
+ *      skiplist_insert_at(&sl, 0, (void *) &data);
+ *
+ *      skiplist_get_by_index(&sl, 1, (void *) &data);
+ *      printf("Value at position 1: %d\n", data);
+ *
+ *      skiplist_destroy(&sl);
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+******************************************************************************/
+#include "Skip_list.h"          /* Node and skip list typedefs */
+
+/******************************************************************************
+* Module Preprocessor Constants
+******************************************************************************/
+/**
+ * Initial state of the level generator, it must not be 0
+ */
+#define SKIPLIST_SEED       0x9E3779B9u
+
+
+/******************************************************************************
+* Module Preprocessor Macros
+******************************************************************************/
+/**
+ * Pointer to the data stored after the links of a node
+ */
+#define NODE_DATA(node)     ((unsigned char *) &((node)->links[(node)->level]))
+/**
+ * Size in bytes of a node with a given number of levels
+ */
+#define NODE_BYTES(level, dataSize) (sizeof(struct skiplist_node_t) + \
+                                     (level) * sizeof(skiplist_link_t) + \
+                                     (dataSize))
+
+
+/******************************************************************************
+* Module Typedefs
+******************************************************************************/
+
+
+/******************************************************************************
+* Module Variable Definitions
+******************************************************************************/
+
+
+/******************************************************************************
+* Function Prototypes
+******************************************************************************/
+static size_t random_level(skiplist_t* list);
+static skiplist_node_t* find_position(skiplist_t* list, size_t position, skiplist_node_t** update, size_t* rank);
+static uint8_t _skiplist_insert_at(skiplist_t* list, size_t index, const void* data);
+static uint8_t _skiplist_remove_at(skiplist_t* list, size_t index, void* data);
+static uint8_t _skiplist_get_by_index(skiplist_t* list, size_t index, void* data);
+static void _skiplist_for_each(skiplist_t* list, void (*eachFn)(const void* data, void* arg), void* arg);
+static void print_element(const void* data, void* arg);
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+
+
+/*****************************************************************************/
+/*!
+ *
+ * @addtogroup skip_list
+ * @{
+ *
+ */
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to choose the number of levels of a new node with a
+ * xorshift generator. Every pair of bits of the random number which is 0
+ * adds a level, so a node reaches each level with a probability of 1/4.
+ * This function is private and it must only be used by internal methods.
+ *
+ * @param list Skip list.
+ *
+ * @return Number of levels, between 1 and SKIPLIST_MAX_LEVEL.
+ *
+ */
+/*****************************************************************************/
+static size_t
+random_level(skiplist_t* list)
+{
+    uint32_t x = list->seed;
+    size_t level = 1;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    list->seed = x;
+
+    while (level < SKIPLIST_MAX_LEVEL && (x & 3) == 0)
+      {
+          level++;
+          x >>= 2;
+      }
+
+    return level;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to get the node at a given position, where the head
+ * is the position 0 and the element at index i is at the position i + 1.
+ * It walks from the highest level in use to the lowest one. This function
+ * is private and it must only be used by internal methods.
+ *
+ * @param list Skip list.
+ * @param position Position of the node.
+ * @param update Array where the last node visited at every level is stored,
+ *               or NULL.
+ * @param rank Array where the position of the nodes of update is stored, or
+ *             NULL.
+ *
+ * @return A pointer to the node at the given position.
+ *
+ */
+/*****************************************************************************/
+static skiplist_node_t*
+find_position(skiplist_t* list, size_t position,
+              skiplist_node_t** update, size_t* rank)
+{
+    skiplist_node_t* node = list->head;
+    size_t current = 0;
+    size_t lvl = list->level;
+
+    while (lvl-- > 0)
+      {
+          while (node->links[lvl].next != NULL &&
+                 current + node->links[lvl].span <= position)
+            {
+                current += node->links[lvl].span;
+                node = node->links[lvl].next;
+            }
+
+          if (update != NULL)
+            {
+                update[lvl] = node;
+                rank[lvl] = current;
+            }
+      }
+
+    return node;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to intialize an indexed skip list structure.
+ *
+ * @param list Skip list to be initialized.
+ * @param dataSize Size of the data of the elements.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      skiplist_t list;
+ *      skiplist_init(&list, sizeof(uint32_t));
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+skiplist_init(skiplist_t* list, size_t dataSize)
+{
+    atomic_init(&(list->numElements), 0);
+    list->dataSize = dataSize;
+    list->level = 1;
+    list->seed = SKIPLIST_SEED;
+
+    // The head is a node without data with the links of every level
+    list->head = (skiplist_node_t *) malloc(NODE_BYTES(SKIPLIST_MAX_LEVEL, 0));
+    list->head->level = SKIPLIST_MAX_LEVEL;
+    memset(list->head->links, 0, SKIPLIST_MAX_LEVEL * sizeof(skiplist_link_t));
+
+    // The mutex is used to avoid working with a busy list
+    pthread_mutex_init(&(list->lock), NULL);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to release the memory of the list elements. The
+ * list can still be used.
+ *
+ * @param list Skip list to free the memory of its elements.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      skiplist_free(&list);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+skiplist_free(skiplist_t* list)
+{
+    skiplist_node_t* node = list->head->links[0].next;
+    skiplist_node_t* next;
+
+    while (node != NULL)
+      {
+          next = node->links[0].next;
+          free(node);
+          node = next;
+      }
+
+    memset(list->head->links, 0, SKIPLIST_MAX_LEVEL * sizeof(skiplist_link_t));
+    list->level = 1;
+    atomic_store(&(list->numElements), 0);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to free the memory of the list elements, of the
+ * head and of the mutex.
+ *
+ * @param list Skip list to free the memory of the elements and mutex.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      skiplist_destroy(&list);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+skiplist_destroy(skiplist_t* list)
+{
+    skiplist_free(list);
+    free(list->head);
+    list->head = NULL;
+    pthread_mutex_destroy(&(list->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to insert an element at a given index. The spans
+ * of the links which skip over the new node are increased by one.
+ *
+ * @param list Skip list.
+ * @param index Index the new element will have, up to the number of
+ *              elements.
+ * @param data Pointer to the variable which value will be inserted.
+ *
+ * @return 1 if the given index is out of limits, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_skiplist_insert_at(skiplist_t* list, size_t index, const void* data)
+{
+    skiplist_node_t* update[SKIPLIST_MAX_LEVEL];
+    size_t rank[SKIPLIST_MAX_LEVEL];
+    skiplist_node_t* node;
+    size_t level;
+    size_t lvl;
+
+    if (index > list->numElements)
+      {
+          return 1;
+      }
+
+    find_position(list, index, update, rank);
+
+    level = random_level(list);
+    if (level > list->level)
+      {
+          // The new levels start at the head and skip over the whole list
+          for (lvl = list->level; lvl < level; lvl++)
+            {
+                update[lvl] = list->head;
+                rank[lvl] = 0;
+                list->head->links[lvl].span = list->numElements;
+            }
+          list->level = level;
+      }
+
+    node = (skiplist_node_t *) malloc(NODE_BYTES(level, list->dataSize));
+    node->level = level;
+    memcpy(NODE_DATA(node), data, list->dataSize);
+
+    for (lvl = 0; lvl < level; lvl++)
+      {
+          node->links[lvl].next = update[lvl]->links[lvl].next;
+          node->links[lvl].span = update[lvl]->links[lvl].span -
+                                  (rank[0] - rank[lvl]);
+          update[lvl]->links[lvl].next = node;
+          update[lvl]->links[lvl].span = rank[0] - rank[lvl] + 1;
+      }
+
+    for (lvl = level; lvl < list->level; lvl++)
+      {
+          update[lvl]->links[lvl].span++;
+      }
+
+    list->numElements++;
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to insert an element at a given index in
+ * O(log n). The elements from that index on are moved one position back.
+ *
+ * @param list Skip list.
+ * @param index Index the new element will have, up to the number of
+ *              elements.
+ * @param data Pointer to the variable which value will be inserted.
+ *
+ * @return 1 if the given index is out of limits, 0 otherwise.
+ *
+ * \b Example:
+ * @code
+ *      uint8_t error = skiplist_insert_at(&list, 3, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+skiplist_insert_at(skiplist_t* list, size_t index, const void* data)
+{
+    uint8_t retval;
+
+    pthread_mutex_lock(&(list->lock));
+        retval = _skiplist_insert_at(list, index, data);
+    pthread_mutex_unlock(&(list->lock));
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to add an element to the end of the list.
+ *
+ * @param list Skip list.
+ * @param data Pointer to the variable which value will be inserted at the end
+ *             of the list.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      skiplist_push(&list, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+skiplist_push(skiplist_t* list, const void* data)
+{
+    pthread_mutex_lock(&(list->lock));
+        _skiplist_insert_at(list, list->numElements, data);
+    pthread_mutex_unlock(&(list->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to add an element to the front of the list.
+ *
+ * @param list Skip list.
+ * @param data Pointer to the variable which value will be inserted at the
+ *             front of the list.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      skiplist_push_front(&list, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+skiplist_push_front(skiplist_t* list, const void* data)
+{
+    pthread_mutex_lock(&(list->lock));
+        _skiplist_insert_at(list, 0, data);
+    pthread_mutex_unlock(&(list->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to get and delete the element at a given index. The
+ * links pointing to the node are moved past it and the spans of the links
+ * which skip over it are decreased by one.
+ *
+ * @param list Skip list.
+ * @param index Index of the element.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element.
+ *
+ * @return 1 if the given index is out of limits, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_skiplist_remove_at(skiplist_t* list, size_t index, void* data)
+{
+    skiplist_node_t* update[SKIPLIST_MAX_LEVEL];
+    size_t rank[SKIPLIST_MAX_LEVEL];
+    skiplist_node_t* node;
+    size_t lvl;
+
+    // Check if index is between limits of the list
+    if (index >= list->numElements)
+      {
+          return 1;
+      }
+
+    node = find_position(list, index, update, rank)->links[0].next;
+
+    for (lvl = 0; lvl < list->level; lvl++)
+      {
+          if (update[lvl]->links[lvl].next == node)
+            {
+                update[lvl]->links[lvl].span += node->links[lvl].span - 1;
+                update[lvl]->links[lvl].next = node->links[lvl].next;
+            }
+          else
+            {
+                update[lvl]->links[lvl].span--;
+            }
+      }
+
+    // Drop the levels left empty
+    while (list->level > 1 &&
+           list->head->links[list->level - 1].next == NULL)
+      {
+          list->level--;
+      }
+
+    memcpy(data, NODE_DATA(node), list->dataSize);
+    free(node);
+    list->numElements--;
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get and delete the element at a given index in
+ * O(log n).
+ *
+ * @param list Skip list.
+ * @param index Index of the element.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element.
+ *
+ * @return 1 if the given index is out of limits, 0 otherwise.
+ *
+ * \b Example:
+ * @code
+ *      uint8_t error = skiplist_remove_at(&list, 3, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+skiplist_remove_at(skiplist_t* list, size_t index, void* data)
+{
+    uint8_t retval;
+
+    pthread_mutex_lock(&(list->lock));
+        retval = _skiplist_remove_at(list, index, data);
+    pthread_mutex_unlock(&(list->lock));
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get and delete the element at the end of the
+ * list.
+ *
+ * @param list Skip list.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element at the end of the list.
+ *
+ * @return 1 if there are no elements, 0 otherwise.
+ *
+ * \b Example:
+ * @code
+ *      uint8_t error = skiplist_pop(&list, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+skiplist_pop(skiplist_t* list, void* data)
+{
+    uint8_t retval;
+
+    pthread_mutex_lock(&(list->lock));
+        retval = _skiplist_remove_at(list, list->numElements - 1, data);
+    pthread_mutex_unlock(&(list->lock));
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get and delete the element at the front of the
+ * list.
+ *
+ * @param list Skip list.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element at the front of the list.
+ *
+ * @return 1 if there are no elements, 0 otherwise.
+ *
+ * \b Example:
+ * @code
+ *      uint8_t error = skiplist_pop_front(&list, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+skiplist_pop_front(skiplist_t* list, void* data)
+{
+    uint8_t retval;
+
+    pthread_mutex_lock(&(list->lock));
+        retval = _skiplist_remove_at(list, 0, data);
+    pthread_mutex_unlock(&(list->lock));
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to get the value of the element at a given index.
+ * It doesn't delete the element.
+ *
+ * @param list Skip list.
+ * @param index Index of the element.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element at the given index.
+ *
+ * @return 1 if the given index is out of limits, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_skiplist_get_by_index(skiplist_t* list, size_t index, void* data)
+{
+    skiplist_node_t* node;
+
+    // Check if index is between limits of the list
+    if (index >= list->numElements)
+      {
+          return 1;
+      }
+
+    node = find_position(list, index + 1, NULL, NULL);
+    memcpy(data, NODE_DATA(node), list->dataSize);
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get the value of the element at a given index in
+ * O(log n). It doesn't delete the element.
+ *
+ * @param list Skip list.
+ * @param index Index of the element.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element at the given index.
+ *
+ * @return 1 if the given index is out of limits, 0 otherwise.
+ *
+ * \b Example:
+ * @code
+ *      uint8_t error = skiplist_get_by_index(&list, 3, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+skiplist_get_by_index(skiplist_t* list, size_t index, void* data)
+{
+    uint8_t retval;
+
+    pthread_mutex_lock(&(list->lock));
+        retval = _skiplist_get_by_index(list, index, data);
+    pthread_mutex_unlock(&(list->lock));
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to call a function for every element of the list,
+ * following the links of the lowest level.
+ *
+ * @param list Skip list.
+ * @param eachFn Pointer to the function called for every element.
+ * @param arg Argument passed to eachFn.
+ *
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_skiplist_for_each(skiplist_t* list,
+                   void (*eachFn)(const void* data, void* arg),
+                   void* arg)
+{
+    skiplist_node_t* node = list->head->links[0].next;
+
+    while (node != NULL)
+      {
+          eachFn(NODE_DATA(node), arg);
+          node = node->links[0].next;
+      }
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to print a single element through the print
+ * function passed as argument. It has the signature expected by
+ * _skiplist_for_each.
+ *
+ * @param data Pointer to the element.
+ * @param arg Pointer to the print function.
+ *
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+print_element(const void* data, void* arg)
+{
+    void (**printFn)(const void* data) = arg;
+
+    (*printFn)(data);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to print the values of the list.
+ *
+ * @param list Skip list.
+ * @param printFn Pointer to the function used to print the elements.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      skiplist_print(&list, printInt);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+skiplist_print(skiplist_t* list, void (*printFn)(const void* data))
+{
+    pthread_mutex_lock(&(list->lock));
+        _skiplist_for_each(list, print_element, (void *) &printFn);
+        printf("\n");
+    pthread_mutex_unlock(&(list->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to call a function for every element of the list,
+ * from the front to the end.
+ *
+ * @param list Skip list.
+ * @param eachFn Pointer to the function called for every element. It
+ *               receives a pointer to the element and arg.
+ * @param arg Argument passed to eachFn.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      skiplist_for_each(&list, sum, (void *) &total);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+skiplist_for_each(skiplist_t* list,
+                  void (*eachFn)(const void* data, void* arg),
+                  void* arg)
+{
+    pthread_mutex_lock(&(list->lock));
+        _skiplist_for_each(list, eachFn, arg);
+    pthread_mutex_unlock(&(list->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get the number of elements in the list. The
+ * number of elements is an atomic counter, so the lock is not taken.
+ *
+ * @param list Skip list.
+ *
+ * @return Number of elements in the list.
+ *
+ * \b Example:
+ * @code
+ *      size_t listSize = skiplist_size(&list);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+size_t
+skiplist_size(skiplist_t* list)
+{
+    return atomic_load_explicit(&(list->numElements), memory_order_relaxed);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * Close the Doxygen group.
+ * @}
+ *
+ */
+/*****************************************************************************/
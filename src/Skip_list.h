@@ -0,0 +1,121 @@
+/******************************************************************************
+* Title                 :   Indexed skip list header file
+* Filename              :   Skip_list.h
+* Author                :   Maximiliano Valencia
+* Origin Date           :   09/02/2019
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   STM32
+* Notes                 :   None
+******************************************************************************/
+/** @file Skip_list.h
+ *  @brief Defines the prototypes of the indexed skip list.
+ *
+ *  This is the header file for the definition of the node and indexed skip
+ *  list structures and typedefs as well as the function prototypes of the
+ *  methods of the indexed skip list.
+ */
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+/******************************************************************************
+* Includes
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+/******************************************************************************
+* Preprocessor Constants
+******************************************************************************/
+/**
+ * Maximum number of levels of a node. With a promotion probability of 1/4
+ * it is enough for 4^16 elements.
+ */
+#define SKIPLIST_MAX_LEVEL  16
+
+
+/******************************************************************************
+* Configuration Constants
+******************************************************************************/
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+/**
+ * Indexed skip list type definition
+ */
+typedef struct skiplist_t skiplist_t;
+/**
+ * Skip list node type definition
+ */
+typedef struct skiplist_node_t skiplist_node_t;
+/**
+ * Skip list link type definition
+ */
+typedef struct skiplist_link_t skiplist_link_t;
+
+/*! @brief Skip list link structure definition
+ *
+ *  The span of a link is the number of positions moved forward by following
+ *  it, which is what makes positional access O(log n).
+ */
+struct skiplist_link_t
+{
+    skiplist_node_t* next;  /**< Pointer to the next node of the level */
+    size_t span;            /**< Positions skipped by the link */
+};
+
+/*! @brief Skip list node structure definition
+ *
+ *  The data of the element is stored after the links of the node.
+ */
+struct skiplist_node_t
+{
+    size_t level;           /**< Number of links of the node */
+    skiplist_link_t links[]; /**< Links of the node, one per level */
+};
+
+/*! @brief Indexed skip list structure definition */
+struct skiplist_t
+{
+    atomic_size_t numElements; /**< Number of elements in the list */
+    size_t dataSize;        /**< Size of data of the elements */
+    size_t level;           /**< Number of levels in use */
+    uint32_t seed;          /**< State of the level generator */
+    skiplist_node_t* head;  /**< Sentinel node before the first element */
+    pthread_mutex_t lock;   /**< Mutex used to lock the list */
+};
+
+/******************************************************************************
+* Variables
+******************************************************************************/
+
+
+/******************************************************************************
+* Function Prototypes
+******************************************************************************/
+void skiplist_init(skiplist_t* list, size_t dataSize);
+void skiplist_free(skiplist_t* list);
+void skiplist_destroy(skiplist_t* list);
+void skiplist_push(skiplist_t* list, const void* data);
+void skiplist_push_front(skiplist_t* list, const void* data);
+uint8_t skiplist_pop(skiplist_t* list, void* data);
+uint8_t skiplist_pop_front(skiplist_t* list, void* data);
+uint8_t skiplist_insert_at(skiplist_t* list, size_t index, const void* data);
+uint8_t skiplist_remove_at(skiplist_t* list, size_t index, void* data);
+uint8_t skiplist_get_by_index(skiplist_t* list, size_t index, void* data);
+void skiplist_print(skiplist_t* list, void (*printFn)(const void* data));
+void skiplist_for_each(skiplist_t* list, void (*eachFn)(const void* data, void* arg), void* arg);
+size_t skiplist_size(skiplist_t* list);
+
+#endif /* SKIP_LIST_H */
@@ -0,0 +1,922 @@
+/******************************************************************************
+* Title                 :   Unrolled linked list source file
+* Filename              :   Unrolled_list.c
+* Author                :   Maximiliano Valencia
+* Origin Date           :   09/02/2019
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   STM32
+* Notes                 :   None
+******************************************************************************/
+/*! @file Unrolled_list.c
+ *  @brief Unrolled linked list implementation
+ *
+ *  To use the unrolled linked list implementation, include this header file
+ *  as follows:
+ *  @code
+ *  #include "Unrolled_list.h"
+ *  @endcode
+ *
+ *  ## Overview ##
+ *  An Unrolled Linked List stores several elements in each node, called a
+ *  block. It offers the same methods as the Linked List (see Linked_list.h)
+ *  but for small elements the memory used by the links is shared by a whole
+ *  block, and iterating the list reads the elements sequentially from
+ *  memory.
+ *
+ *  The elements in use of a block are contiguous. ulist_push and
+ *  ulist_push_front fill the free slots at each end of the blocks at the ends
+ *  of the list, and a new block is only allocated when those are full. The
+ *  last block emptied by a pop is kept as a spare, so a list used as a queue
+ *  doesn't allocate and free a block every time it crosses a block boundary.
+ *
+ *  ## Usage ##
+ *
+ *  The following code example initializes the unrolled linked list, writes
+ *  to it and then gets elements from it.
+ *
+ *  @code
+ *      int16_t data;
+ *      ulist_t ul;
+ *
+ *      ulist_init(&ul, sizeof(int16_t));
+ *
+ *      data = 4;
+ *      ulist_push(&ul, (void *) &data);
+ *      data = 17;
+ *      ulist_push(&ul, (void *) &data);
+ *
+ *      ulist_get_by_index(&ul, 1, (void *) &data);
+ *      printf("Value at position 1: %d\n", data);
+ *
+ *      ulist_destroy(&ul);
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+******************************************************************************/
+#include "Unrolled_list.h"      /* Block and unrolled list typedefs */
+
+/******************************************************************************
+* Module Preprocessor Constants
+******************************************************************************/
+
+
+/******************************************************************************
+* Module Preprocessor Macros
+******************************************************************************/
+/**
+ * Pointer to the given slot of a block
+ */
+#define BLOCK_SLOT(list, block, slot)   ((block)->data + \
+                                         (size_t) (slot) * (list)->dataSize)
+/**
+ * Size in bytes of a block
+ */
+#define BLOCK_BYTES(list)   (sizeof(struct ulist_block_t) + \
+                             (size_t) (list)->elementsPerBlock * \
+                             (list)->dataSize)
+
+
+/******************************************************************************
+* Module Typedefs
+******************************************************************************/
+
+
+/******************************************************************************
+* Module Variable Definitions
+******************************************************************************/
+
+
+/******************************************************************************
+* Function Prototypes
+******************************************************************************/
+static ulist_block_t* create_block(ulist_t* list, uint32_t first);
+static void release_block(ulist_t* list, ulist_block_t* block);
+static void _ulist_push(ulist_t* list, const void* data);
+static void _ulist_push_front(ulist_t* list, const void* data);
+static uint8_t _ulist_pop(ulist_t* list, void* data);
+static uint8_t _ulist_pop_front(ulist_t* list, void* data);
+static uint8_t _ulist_get_by_index(ulist_t* list, size_t index, void* data);
+static void _ulist_for_each(ulist_t* list, void (*eachFn)(const void* data, void* arg), void* arg);
+static void print_element(const void* data, void* arg);
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+
+
+/*****************************************************************************/
+/*!
+ *
+ * @addtogroup unrolled_list
+ * @{
+ *
+ */
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to get an empty block, the spare block if there is
+ * one. This function is private and it must only be used by internal
+ * methods.
+ *
+ * @param list Unrolled list the block belongs to.
+ * @param first Slot where the first element will be stored, 0 to fill the
+ *              block forwards and elementsPerBlock to fill it backwards.
+ *
+ * @return A pointer to the block.
+ *
+ */
+/*****************************************************************************/
+static ulist_block_t*
+create_block(ulist_t* list, uint32_t first)
+{
+    ulist_block_t* block = list->spare;
+
+    if (block != NULL)
+      {
+          list->spare = NULL;
+      }
+    else
+      {
+          block = (ulist_block_t *) malloc(BLOCK_BYTES(list));
+      }
+
+    block->next = NULL;
+    block->prev = NULL;
+    block->first = first;
+    block->count = 0;
+    list->numBlocks++;
+
+    return block;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to release an empty block. It is kept as the spare
+ * block if there is none, otherwise its memory is freed. This function is
+ * private and it must only be used by internal methods.
+ *
+ * @param list Unrolled list the block belongs to.
+ * @param block Block to release.
+ *
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+release_block(ulist_t* list, ulist_block_t* block)
+{
+    list->numBlocks--;
+
+    if (list->spare == NULL)
+      {
+          list->spare = block;
+      }
+    else
+      {
+          free(block);
+      }
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to intialize an unrolled linked list structure with
+ * blocks of ULIST_DEFAULT_BLOCK_SIZE bytes.
+ *
+ * @param list Unrolled list to be initialized.
+ * @param dataSize Size of the data of the elements.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      ulist_t list;
+ *      ulist_init(&list, sizeof(int16_t));
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+ulist_init(ulist_t* list, size_t dataSize)
+{
+    ulist_init_sized(list, dataSize, ULIST_DEFAULT_BLOCK_SIZE);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to intialize an unrolled linked list structure with
+ * blocks of a given size, for example a cache line or a page. The number of
+ * elements per block is the number that fits after the block header, at
+ * least one.
+ *
+ * @param list Unrolled list to be initialized.
+ * @param dataSize Size of the data of the elements.
+ * @param blockSize Size in bytes of the blocks, including their header.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      ulist_t list;
+ *      ulist_init_sized(&list, sizeof(int16_t), 4096);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+ulist_init_sized(ulist_t* list, size_t dataSize, size_t blockSize)
+{
+    size_t elementsPerBlock = 1;
+
+    if (blockSize > sizeof(struct ulist_block_t) + dataSize)
+      {
+          elementsPerBlock = (blockSize - sizeof(struct ulist_block_t)) /
+                             dataSize;
+      }
+
+    if (elementsPerBlock > UINT32_MAX)
+      {
+          elementsPerBlock = UINT32_MAX;
+      }
+
+    atomic_init(&(list->numElements), 0);
+    list->dataSize = dataSize;
+    list->elementsPerBlock = (uint32_t) elementsPerBlock;
+    list->numBlocks = 0;
+    list->head = NULL;
+    list->tail = NULL;
+    list->spare = NULL;
+
+    // The mutex is used to avoid working with a busy list
+    pthread_mutex_init(&(list->lock), NULL);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to release the memory of the unrolled linked list
+ * elements.
+ *
+ * @param list Unrolled list to free the memory of its elements.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      ulist_free(&list);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+ulist_free(ulist_t* list)
+{
+    ulist_block_t* iterator = list->head;
+    ulist_block_t* temp = NULL;
+
+    // Traverse the list and free every block
+    while (iterator != NULL)
+      {
+          temp = iterator->next;
+          free(iterator);
+          iterator = temp;
+      }
+
+    free(list->spare);
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->spare = NULL;
+    list->numBlocks = 0;
+    atomic_store(&(list->numElements), 0);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to free the memory of the unrolled linked list
+ * elements and of the mutex.
+ *
+ * @param list Unrolled list to free the memory of the elements and mutex.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      ulist_destroy(&list);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+ulist_destroy(ulist_t* list)
+{
+    ulist_free(list);
+    pthread_mutex_destroy(&(list->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to add an element to the end of the list.
+ *
+ * @param list Unrolled list.
+ * @param data Pointer to the variable which value will be inserted at the end
+ *             of the list.
+ *
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_ulist_push(ulist_t* list, const void* data)
+{
+    ulist_block_t* block = list->tail;
+
+    // The last block is full up to its last slot
+    if (block == NULL ||
+        block->first + block->count == list->elementsPerBlock)
+      {
+          block = create_block(list, 0);
+          block->prev = list->tail;
+
+          if (list->tail == NULL)
+            {
+                list->head = block;
+            }
+          else
+            {
+                list->tail->next = block;
+            }
+          list->tail = block;
+      }
+
+    memcpy(BLOCK_SLOT(list, block, block->first + block->count), data,
+           list->dataSize);
+    block->count++;
+    list->numElements++;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to add an element to the end of the list.
+ *
+ * @param list Unrolled list.
+ * @param data Pointer to the variable which value will be inserted at the end
+ *             of the list.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      ulist_push(&list, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+ulist_push(ulist_t* list, const void* data)
+{
+    pthread_mutex_lock(&(list->lock));
+        _ulist_push(list, data);
+    pthread_mutex_unlock(&(list->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to add an element to the front of the list.
+ *
+ * @param list Unrolled list.
+ * @param data Pointer to the variable which value will be inserted at the
+ *             front of the list.
+ *
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_ulist_push_front(ulist_t* list, const void* data)
+{
+    ulist_block_t* block = list->head;
+
+    // The first block is full down to its first slot
+    if (block == NULL || block->first == 0)
+      {
+          block = create_block(list, list->elementsPerBlock);
+          block->next = list->head;
+
+          if (list->head == NULL)
+            {
+                list->tail = block;
+            }
+          else
+            {
+                list->head->prev = block;
+            }
+          list->head = block;
+      }
+
+    block->first--;
+    block->count++;
+    memcpy(BLOCK_SLOT(list, block, block->first), data, list->dataSize);
+    list->numElements++;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to add an element to the front of the list.
+ *
+ * @param list Unrolled list.
+ * @param data Pointer to the variable which value will be inserted at the
+ *             front of the list.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      ulist_push_front(&list, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+ulist_push_front(ulist_t* list, const void* data)
+{
+    pthread_mutex_lock(&(list->lock));
+        _ulist_push_front(list, data);
+    pthread_mutex_unlock(&(list->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to get and delete the element at the end of the
+ * list.
+ *
+ * @param list Unrolled list.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element at the end of the list.
+ *
+ * @return 1 if there are no elements, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_ulist_pop(ulist_t* list, void* data)
+{
+    ulist_block_t* block = list->tail;
+
+    // If the list is empty, return error
+    if (block == NULL)
+      {
+          return 1;
+      }
+
+    block->count--;
+    memcpy(data, BLOCK_SLOT(list, block, block->first + block->count),
+           list->dataSize);
+    list->numElements--;
+
+    if (block->count == 0)
+      {
+          list->tail = block->prev;
+          if (list->tail == NULL)
+            {
+                list->head = NULL;
+            }
+          else
+            {
+                list->tail->next = NULL;
+            }
+          release_block(list, block);
+      }
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get and delete the element at the end of the
+ * list.
+ *
+ * @param list Unrolled list.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element at the end of the list.
+ *
+ * @return 1 if there are no elements, 0 otherwise.
+ *
+ * \b Example:
+ * @code
+ *      uint8_t error = ulist_pop(&list, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+ulist_pop(ulist_t* list, void* data)
+{
+    uint8_t retval;
+
+    pthread_mutex_lock(&(list->lock));
+        retval = _ulist_pop(list, data);
+    pthread_mutex_unlock(&(list->lock));
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to get and delete the element at the front of the
+ * list.
+ *
+ * @param list Unrolled list.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element at the front of the list.
+ *
+ * @return 1 if there are no elements, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_ulist_pop_front(ulist_t* list, void* data)
+{
+    ulist_block_t* block = list->head;
+
+    // If the list is empty, return error
+    if (block == NULL)
+      {
+          return 1;
+      }
+
+    memcpy(data, BLOCK_SLOT(list, block, block->first), list->dataSize);
+    block->first++;
+    block->count--;
+    list->numElements--;
+
+    if (block->count == 0)
+      {
+          list->head = block->next;
+          if (list->head == NULL)
+            {
+                list->tail = NULL;
+            }
+          else
+            {
+                list->head->prev = NULL;
+            }
+          release_block(list, block);
+      }
+
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get and delete the element at the front of the
+ * list.
+ *
+ * @param list Unrolled list.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element at the front of the list.
+ *
+ * @return 1 if there are no elements, 0 otherwise.
+ *
+ * \b Example:
+ * @code
+ *      uint8_t error = ulist_pop_front(&list, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+ulist_pop_front(ulist_t* list, void* data)
+{
+    uint8_t retval;
+
+    pthread_mutex_lock(&(list->lock));
+        retval = _ulist_pop_front(list, data);
+    pthread_mutex_unlock(&(list->lock));
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to get the value of the element at a given index.
+ * Whole blocks are skipped, so it only walks one link per block.
+ *
+ * @param list Unrolled list.
+ * @param index Index of the element.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element at the given index.
+ *
+ * @return 1 if the given index is out of limits, 0 otherwise.
+ *
+ */
+/*****************************************************************************/
+static uint8_t
+_ulist_get_by_index(ulist_t* list, size_t index, void* data)
+{
+    ulist_block_t* iterator = list->head;
+
+    // Check if index is between limits of the list
+    if (index >= list->numElements)
+      {
+          return 1;
+      }
+
+    while (index >= iterator->count)
+      {
+          index -= iterator->count;
+          iterator = iterator->next;
+      }
+
+    memcpy(data, BLOCK_SLOT(list, iterator, iterator->first + index),
+           list->dataSize);
+    return 0;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get the value of the element at a given index.
+ * It doesn't delete the element.
+ *
+ * @param list Unrolled list.
+ * @param index Index of the element.
+ * @param data Pointer to the variable to which will be copied the value of the
+ *             element at the given index.
+ *
+ * @return 1 if the given index is out of limits, 0 otherwise.
+ *
+ * \b Example:
+ * @code
+ *      uint8_t error = ulist_get_by_index(&list, 3, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+ulist_get_by_index(ulist_t* list, size_t index, void* data)
+{
+    uint8_t retval;
+
+    pthread_mutex_lock(&(list->lock));
+        retval = _ulist_get_by_index(list, index, data);
+    pthread_mutex_unlock(&(list->lock));
+
+    return retval;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to call a function for every element of the list,
+ * from the front to the end. The elements of a block are visited
+ * sequentially in memory.
+ *
+ * @param list Unrolled list.
+ * @param eachFn Pointer to the function called for every element.
+ * @param arg Argument passed to eachFn.
+ *
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+_ulist_for_each(ulist_t* list,
+                void (*eachFn)(const void* data, void* arg),
+                void* arg)
+{
+    ulist_block_t* iterator = list->head;
+    const unsigned char* element = NULL;
+    uint32_t i;
+
+    while (iterator != NULL)
+      {
+          element = BLOCK_SLOT(list, iterator, iterator->first);
+          for (i = 0; i < iterator->count; i++)
+            {
+                eachFn(element, arg);
+                element += list->dataSize;
+            }
+
+          iterator = iterator->next;
+      }
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to print a single element through the print
+ * function passed as argument. It has the signature expected by
+ * _ulist_for_each.
+ *
+ * @param data Pointer to the element.
+ * @param arg Pointer to the print function.
+ *
+ * @return None.
+ *
+ */
+/*****************************************************************************/
+static void
+print_element(const void* data, void* arg)
+{
+    void (**printFn)(const void* data) = arg;
+
+    (*printFn)(data);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to print the values of the list.
+ *
+ * @param list Unrolled list.
+ * @param printFn Pointer to the function used to print the elements.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      ulist_print(&list, printInt);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+ulist_print(ulist_t* list, void (*printFn)(const void* data))
+{
+    pthread_mutex_lock(&(list->lock));
+        _ulist_for_each(list, print_element, (void *) &printFn);
+        printf("\n");
+    pthread_mutex_unlock(&(list->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to call a function for every element of the list,
+ * from the front to the end.
+ *
+ * @param list Unrolled list.
+ * @param eachFn Pointer to the function called for every element. It
+ *               receives a pointer to the element and arg.
+ * @param arg Argument passed to eachFn.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      ulist_for_each(&list, sum, (void *) &total);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+ulist_for_each(ulist_t* list,
+               void (*eachFn)(const void* data, void* arg),
+               void* arg)
+{
+    pthread_mutex_lock(&(list->lock));
+        _ulist_for_each(list, eachFn, arg);
+    pthread_mutex_unlock(&(list->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get the number of elements in the list. The
+ * number of elements is an atomic counter, so the lock is not taken.
+ *
+ * @param list Unrolled list.
+ *
+ * @return Number of elements in the list.
+ *
+ * \b Example:
+ * @code
+ *      size_t listSize = ulist_size(&list);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+size_t
+ulist_size(ulist_t* list)
+{
+    return atomic_load_explicit(&(list->numElements), memory_order_relaxed);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get information about the blocks of the list.
+ *
+ * @param list Unrolled list.
+ * @param info Pointer to the structure to which will be copied the
+ *             information.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      ulist_info_t info;
+ *      ulist_info(&list, &info);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+ulist_info(ulist_t* list, ulist_info_t* info)
+{
+    pthread_mutex_lock(&(list->lock));
+        info->elementsPerBlock = list->elementsPerBlock;
+        info->numBlocks = list->numBlocks;
+        info->numBytes = (list->numBlocks + (list->spare != NULL)) *
+                         BLOCK_BYTES(list);
+    pthread_mutex_unlock(&(list->lock));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * Close the Doxygen group.
+ * @}
+ *
+ */
+/*****************************************************************************/
@@ -0,0 +1,124 @@
+/******************************************************************************
+* Title                 :   Unrolled linked list header file
+* Filename              :   Unrolled_list.h
+* Author                :   Maximiliano Valencia
+* Origin Date           :   09/02/2019
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   STM32
+* Notes                 :   None
+******************************************************************************/
+/** @file Unrolled_list.h
+ *  @brief Defines the prototypes of the unrolled linked list.
+ *
+ *  This is the header file for the definition of the block and unrolled
+ *  linked list structures and typedefs as well as the function prototypes of
+ *  the methods of the unrolled linked list.
+ */
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+/******************************************************************************
+* Includes
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+/******************************************************************************
+* Preprocessor Constants
+******************************************************************************/
+/**
+ * Default size in bytes of the blocks of an unrolled list, four cache lines
+ */
+#define ULIST_DEFAULT_BLOCK_SIZE    256
+
+
+/******************************************************************************
+* Configuration Constants
+******************************************************************************/
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+/**
+ * Unrolled linked list type definition
+ */
+typedef struct ulist_t ulist_t;
+/**
+ * Block type definition
+ */
+typedef struct ulist_block_t ulist_block_t;
+/**
+ * Unrolled linked list information type definition
+ */
+typedef struct ulist_info_t ulist_info_t;
+
+/*! @brief Block structure definition
+ *
+ *  A block stores up to ulist_t.elementsPerBlock elements contiguously. The
+ *  elements in use are the ones from first to first + count - 1, so both
+ *  ends of the block can grow without moving the data.
+ */
+struct ulist_block_t
+{
+    ulist_block_t* next;    /**< Pointer to the next block */
+    ulist_block_t* prev;    /**< Pointer to the previous block */
+    uint32_t first;         /**< Slot of the first element in use */
+    uint32_t count;         /**< Number of elements in use */
+    unsigned char data[];   /**< Slots of the elements */
+};
+
+/*! @brief Unrolled linked list structure definition */
+struct ulist_t
+{
+    atomic_size_t numElements; /**< Number of elements in the list */
+    size_t dataSize;        /**< Size of data of the elements */
+    uint32_t elementsPerBlock; /**< Number of slots of each block */
+    size_t numBlocks;       /**< Number of blocks in use */
+    ulist_block_t* head;    /**< Pointer to the first block */
+    ulist_block_t* tail;    /**< Pointer to the last block */
+    ulist_block_t* spare;   /**< Empty block kept to be reused */
+    pthread_mutex_t lock;   /**< Mutex used to lock the list */
+};
+
+/*! @brief Unrolled linked list information structure definition */
+struct ulist_info_t
+{
+    uint32_t elementsPerBlock; /**< Number of slots of each block */
+    size_t numBlocks;       /**< Number of blocks in use */
+    size_t numBytes;        /**< Bytes allocated by the blocks */
+};
+
+/******************************************************************************
+* Variables
+******************************************************************************/
+
+
+/******************************************************************************
+* Function Prototypes
+******************************************************************************/
+void ulist_init(ulist_t* list, size_t dataSize);
+void ulist_init_sized(ulist_t* list, size_t dataSize, size_t blockSize);
+void ulist_free(ulist_t* list);
+void ulist_destroy(ulist_t* list);
+void ulist_push(ulist_t* list, const void* data);
+void ulist_push_front(ulist_t* list, const void* data);
+uint8_t ulist_pop(ulist_t* list, void* data);
+uint8_t ulist_pop_front(ulist_t* list, void* data);
+uint8_t ulist_get_by_index(ulist_t* list, size_t index, void* data);
+void ulist_print(ulist_t* list, void (*printFn)(const void* data));
+void ulist_for_each(ulist_t* list, void (*eachFn)(const void* data, void* arg), void* arg);
+size_t ulist_size(ulist_t* list);
+void ulist_info(ulist_t* list, ulist_info_t* info);
+
+#endif /* UNROLLED_LIST_H */
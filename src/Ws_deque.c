@@ -0,0 +1,598 @@
+/******************************************************************************
+* Title                 :   Work-stealing deque source file
+* Filename              :   Ws_deque.c
+* Author                :   Maximiliano Valencia
+* Origin Date           :   09/02/2019
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   STM32
+* Notes                 :   None
+******************************************************************************/
+/*! @file Ws_deque.c
+ *  @brief Work-stealing deque implementation
+ *
+ *  To use the work-stealing deque implementation, include this header file
+ *  as follows:
+ *  @code
+ *  #include "Ws_deque.h"
+ *  @endcode
+ *
+ *  ## Overview ##
+ *  A Work-stealing Deque is the Chase-Lev deque used by the schedulers that
+ *  keep one deque of tasks per worker thread. The thread that owns the deque
+ *  pushes and pops at its bottom, like list_push and list_pop of the Linked
+ *  List (see Linked_list.h), and the other threads steal the oldest elements
+ *  from its top, like list_pop_front. No method takes a lock: the owner only
+ *  needs a compare and swap when it pops the last element, and a thief uses
+ *  one to claim the element it copied.
+ *
+ *  wsdeque_push and wsdeque_pop must only be called by the owner thread,
+ *  wsdeque_steal can be called by any thread. The elements are copied like
+ *  in the other containers, and the buffer doubles its capacity when it is
+ *  full. The replaced buffers can still be read by a thief, so they are only
+ *  freed by wsdeque_destroy.
+ *
+ *  ## Usage ##
+ *
+ *  The following code example initializes the work-stealing deque, pushes
+ *  two elements as the owner and steals the oldest one.
+ *
+ *  @code
+ *      int data;
+ *      wsdeque_t dq;
+ *
+ *      wsdeque_init(&dq, sizeof(int));
+ *
+ *      data = 4;
+ *      wsdeque_push(&dq, (void *) &data);
+ *      data = 17;
+ *      wsdeque_push(&dq, (void *) &data);
+ *
+ *      // From another thread
+ *      wsdeque_steal(&dq, (void *) &data);
+ *      printf("Stolen: %d\n", data);
+ *
+ *      wsdeque_destroy(&dq);
+ *  @endcode
+ */
+/******************************************************************************
+* Includes
+******************************************************************************/
+#include "Ws_deque.h"           /* Work-stealing deque structure typedef */
+
+/******************************************************************************
+* Module Preprocessor Constants
+******************************************************************************/
+
+
+/******************************************************************************
+* Module Preprocessor Macros
+******************************************************************************/
+/**
+ * Pointer to the first word of the slot of the element at a given position
+ */
+#define WSDEQUE_SLOT(deque, buffer, position) \
+                                    ((buffer)->words + \
+                                     ((size_t) (position) & \
+                                      ((buffer)->capacity - 1)) * \
+                                     (deque)->slotWords)
+
+
+/******************************************************************************
+* Module Typedefs
+******************************************************************************/
+
+
+/******************************************************************************
+* Module Variable Definitions
+******************************************************************************/
+
+
+/******************************************************************************
+* Function Prototypes
+******************************************************************************/
+static wsdeque_buffer_t* _wsdeque_buffer(wsdeque_t* deque, size_t capacity);
+static void _wsdeque_write(wsdeque_t* deque, atomic_uintptr_t* slot,
+                           const void* data);
+static void _wsdeque_read(wsdeque_t* deque, atomic_uintptr_t* slot,
+                          void* data);
+static wsdeque_buffer_t* _wsdeque_grow(wsdeque_t* deque,
+                                       wsdeque_buffer_t* buffer,
+                                       long long top, long long bottom);
+
+/******************************************************************************
+* Function Definitions
+******************************************************************************/
+
+
+/*****************************************************************************/
+/*!
+ *
+ * @addtogroup ws_deque
+ * @{
+ *
+ */
+/*****************************************************************************/
+
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to allocate a buffer for the elements of the deque.
+ *
+ * @param deque Work-stealing deque.
+ * @param capacity Number of slots, a power of two.
+ *
+ * @return Pointer to the buffer.
+ *
+ * \b Example:
+ * @code
+ *      wsdeque_buffer_t* buffer = _wsdeque_buffer(deque, 64);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+static wsdeque_buffer_t*
+_wsdeque_buffer(wsdeque_t* deque, size_t capacity)
+{
+    wsdeque_buffer_t* buffer;
+
+    buffer = (wsdeque_buffer_t *) malloc(sizeof(wsdeque_buffer_t) +
+                                         capacity * deque->slotWords *
+                                         sizeof(atomic_uintptr_t));
+    buffer->capacity = capacity;
+    buffer->retired = NULL;
+
+    return buffer;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to copy an element into a slot one word at a time.
+ * The words are stored atomically because a thief may be reading the slot.
+ *
+ * @param deque Work-stealing deque.
+ * @param slot First word of the slot.
+ * @param data Element to be copied.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      _wsdeque_write(deque, WSDEQUE_SLOT(deque, buffer, b), data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+static void
+_wsdeque_write(wsdeque_t* deque, atomic_uintptr_t* slot, const void* data)
+{
+    const unsigned char* bytes = (const unsigned char *) data;
+    size_t remaining = deque->dataSize;
+    uintptr_t word;
+    size_t i;
+
+    for (i = 0; i < deque->slotWords; i++)
+      {
+          word = 0;
+          memcpy(&word, bytes, remaining < sizeof(word) ?
+                               remaining : sizeof(word));
+          atomic_store_explicit(&slot[i], word, memory_order_relaxed);
+
+          bytes += sizeof(word);
+          remaining -= remaining < sizeof(word) ? remaining : sizeof(word);
+      }
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to copy an element out of a slot one word at a
+ * time.
+ *
+ * @param deque Work-stealing deque.
+ * @param slot First word of the slot.
+ * @param data Pointer to the memory where the element is copied.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      _wsdeque_read(deque, WSDEQUE_SLOT(deque, buffer, t), data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+static void
+_wsdeque_read(wsdeque_t* deque, atomic_uintptr_t* slot, void* data)
+{
+    unsigned char* bytes = (unsigned char *) data;
+    size_t remaining = deque->dataSize;
+    uintptr_t word;
+    size_t i;
+
+    for (i = 0; i < deque->slotWords; i++)
+      {
+          word = atomic_load_explicit(&slot[i], memory_order_relaxed);
+          memcpy(bytes, &word, remaining < sizeof(word) ?
+                               remaining : sizeof(word));
+
+          bytes += sizeof(word);
+          remaining -= remaining < sizeof(word) ? remaining : sizeof(word);
+      }
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * @internal
+ *
+ * \b Description:
+ *
+ * This function is used to replace a full buffer with one of twice its
+ * capacity. The old buffer is kept in the retired chain of the new one
+ * because a thief may still be reading it.
+ *
+ * @param deque Work-stealing deque.
+ * @param buffer Full buffer.
+ * @param top Position of the oldest element.
+ * @param bottom Position after the newest element.
+ *
+ * @return Pointer to the new buffer.
+ *
+ * \b Example:
+ * @code
+ *      buffer = _wsdeque_grow(deque, buffer, t, b);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+static wsdeque_buffer_t*
+_wsdeque_grow(wsdeque_t* deque, wsdeque_buffer_t* buffer,
+              long long top, long long bottom)
+{
+    wsdeque_buffer_t* grown = _wsdeque_buffer(deque, buffer->capacity << 1);
+    atomic_uintptr_t* from;
+    atomic_uintptr_t* to;
+    long long position;
+    size_t i;
+
+    for (position = top; position < bottom; position++)
+      {
+          from = WSDEQUE_SLOT(deque, buffer, position);
+          to = WSDEQUE_SLOT(deque, grown, position);
+          for (i = 0; i < deque->slotWords; i++)
+            {
+                atomic_store_explicit(&to[i],
+                                      atomic_load_explicit(&from[i],
+                                                       memory_order_relaxed),
+                                      memory_order_relaxed);
+            }
+      }
+
+    grown->retired = buffer;
+    atomic_store_explicit(&(deque->buffer), grown, memory_order_release);
+
+    return grown;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to intialize a work-stealing deque structure with
+ * room for WSDEQUE_INITIAL_CAPACITY elements.
+ *
+ * @param deque Work-stealing deque to be initialized.
+ * @param dataSize Size of the data to be stored in the deque.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      wsdeque_t deque;
+ *      wsdeque_init(&deque, sizeof(int));
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+wsdeque_init(wsdeque_t* deque, size_t dataSize)
+{
+    wsdeque_init_capacity(deque, dataSize, WSDEQUE_INITIAL_CAPACITY);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to intialize a work-stealing deque structure with
+ * room for a given number of elements, rounded up to a power of two.
+ *
+ * @param deque Work-stealing deque to be initialized.
+ * @param dataSize Size of the data to be stored in the deque.
+ * @param capacity Number of elements the deque holds before growing.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      wsdeque_t deque;
+ *      wsdeque_init_capacity(&deque, sizeof(int), 1024);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+wsdeque_init_capacity(wsdeque_t* deque, size_t dataSize, size_t capacity)
+{
+    size_t slots = 1;
+
+    while (slots < capacity)
+      {
+          slots <<= 1;
+      }
+
+    deque->dataSize = dataSize;
+    deque->slotWords = (dataSize + sizeof(uintptr_t) - 1) / sizeof(uintptr_t);
+    if (deque->slotWords == 0)
+      {
+          deque->slotWords = 1;
+      }
+
+    atomic_init(&(deque->top), 0);
+    atomic_init(&(deque->bottom), 0);
+    atomic_init(&(deque->buffer), _wsdeque_buffer(deque, slots));
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to free the current and the replaced buffers of
+ * the deque. No thread may use the deque during or after this call.
+ *
+ * @param deque Work-stealing deque.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      wsdeque_destroy(&deque);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+wsdeque_destroy(wsdeque_t* deque)
+{
+    wsdeque_buffer_t* buffer;
+    wsdeque_buffer_t* retired;
+
+    buffer = atomic_load_explicit(&(deque->buffer), memory_order_relaxed);
+    while (buffer != NULL)
+      {
+          retired = buffer->retired;
+          free(buffer);
+          buffer = retired;
+      }
+
+    atomic_store_explicit(&(deque->buffer), NULL, memory_order_relaxed);
+    atomic_store_explicit(&(deque->top), 0, memory_order_relaxed);
+    atomic_store_explicit(&(deque->bottom), 0, memory_order_relaxed);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to add an element at the bottom of the deque. It
+ * must only be called by the owner thread.
+ *
+ * @param deque Work-stealing deque.
+ * @param data Element to be added.
+ *
+ * @return None.
+ *
+ * \b Example:
+ * @code
+ *      int data = 4;
+ *      wsdeque_push(&deque, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+void
+wsdeque_push(wsdeque_t* deque, const void* data)
+{
+    long long b = atomic_load_explicit(&(deque->bottom), memory_order_relaxed);
+    long long t = atomic_load_explicit(&(deque->top), memory_order_acquire);
+    wsdeque_buffer_t* buffer = atomic_load_explicit(&(deque->buffer),
+                                                    memory_order_relaxed);
+
+    if (b - t > (long long) buffer->capacity - 1)
+      {
+          buffer = _wsdeque_grow(deque, buffer, t, b);
+      }
+
+    _wsdeque_write(deque, WSDEQUE_SLOT(deque, buffer, b), data);
+
+    // Publish the element to the thieves
+    atomic_store_explicit(&(deque->bottom), b + 1, memory_order_release);
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to remove the newest element from the bottom of
+ * the deque. It must only be called by the owner thread.
+ *
+ * @param deque Work-stealing deque.
+ * @param data Pointer to the memory where the element is copied.
+ *
+ * @return 0 if the element was popped, 1 if the deque was empty or a thief
+ *         took the last element. On error the data is left as it was.
+ *
+ * \b Example:
+ * @code
+ *      int data;
+ *      uint8_t error = wsdeque_pop(&deque, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+wsdeque_pop(wsdeque_t* deque, void* data)
+{
+    long long b = atomic_load_explicit(&(deque->bottom),
+                                       memory_order_relaxed) - 1;
+    wsdeque_buffer_t* buffer = atomic_load_explicit(&(deque->buffer),
+                                                    memory_order_relaxed);
+    long long t;
+    uint8_t error = 0;
+
+    // Claim the bottom element before looking at top, so a thief either
+    // sees the new bottom or the owner sees the thief's top
+    atomic_store_explicit(&(deque->bottom), b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    t = atomic_load_explicit(&(deque->top), memory_order_relaxed);
+
+    if (t > b)
+      {
+          atomic_store_explicit(&(deque->bottom), b + 1, memory_order_relaxed);
+          return 1;
+      }
+
+    if (t == b)
+      {
+          // Last element, race the thieves for it. It is only copied once
+          // it is won, its slot is only overwritten by the owner
+          if (!atomic_compare_exchange_strong_explicit(&(deque->top), &t,
+                                                       t + 1,
+                                                       memory_order_seq_cst,
+                                                       memory_order_relaxed))
+            {
+                error = 1;
+            }
+          atomic_store_explicit(&(deque->bottom), b + 1, memory_order_relaxed);
+      }
+
+    if (error == 0)
+      {
+          _wsdeque_read(deque, WSDEQUE_SLOT(deque, buffer, b), data);
+      }
+
+    return error;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to remove the oldest element from the top of the
+ * deque. It can be called by any thread. A steal that loses the element to
+ * another thief tries again with the next one.
+ *
+ * @param deque Work-stealing deque.
+ * @param data Pointer to the memory where the element is copied.
+ *
+ * @return 0 if the element was stolen, 1 if the deque was empty.
+ *
+ * \b Example:
+ * @code
+ *      int data;
+ *      uint8_t error = wsdeque_steal(&victim, (void *) &data);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+uint8_t
+wsdeque_steal(wsdeque_t* deque, void* data)
+{
+    wsdeque_buffer_t* buffer;
+    long long t;
+    long long b;
+
+    for (;;)
+      {
+          t = atomic_load_explicit(&(deque->top), memory_order_acquire);
+          atomic_thread_fence(memory_order_seq_cst);
+          b = atomic_load_explicit(&(deque->bottom), memory_order_acquire);
+
+          if (t >= b)
+            {
+                return 1;
+            }
+
+          // The element is copied before claiming it, the owner only
+          // overwrites its slot after top has moved past it
+          buffer = atomic_load_explicit(&(deque->buffer),
+                                        memory_order_acquire);
+          _wsdeque_read(deque, WSDEQUE_SLOT(deque, buffer, t), data);
+
+          if (atomic_compare_exchange_strong_explicit(&(deque->top), &t,
+                                                      t + 1,
+                                                      memory_order_seq_cst,
+                                                      memory_order_relaxed))
+            {
+                return 0;
+            }
+      }
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * \b Description:
+ *
+ * This function is used to get the number of elements in the deque. While
+ * other threads use the deque the number is only an estimate.
+ *
+ * @param deque Work-stealing deque.
+ *
+ * @return Number of elements in the deque.
+ *
+ * \b Example:
+ * @code
+ *      size_t dequeSize = wsdeque_size(&deque);
+ * @endcode
+ *
+ */
+/*****************************************************************************/
+size_t
+wsdeque_size(wsdeque_t* deque)
+{
+    long long b = atomic_load_explicit(&(deque->bottom), memory_order_relaxed);
+    long long t = atomic_load_explicit(&(deque->top), memory_order_relaxed);
+
+    return b > t ? (size_t) (b - t) : 0;
+}
+
+/*****************************************************************************/
+/*!
+ *
+ * Close the Doxygen group.
+ * @}
+ *
+ */
+/*****************************************************************************/
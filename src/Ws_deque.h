@@ -0,0 +1,112 @@
+/******************************************************************************
+* Title                 :   Work-stealing deque header file
+* Filename              :   Ws_deque.h
+* Author                :   Maximiliano Valencia
+* Origin Date           :   09/02/2019
+* Version               :   1.0.0
+* Compiler              :   gcc
+* Target                :   STM32
+* Notes                 :   None
+******************************************************************************/
+/** @file Ws_deque.h
+ *  @brief Defines the prototypes of the work-stealing deque.
+ *
+ *  This is the header file for the definition of the buffer and work-stealing
+ *  deque structures and typedefs as well as the function prototypes of the
+ *  methods of the work-stealing deque.
+ */
+#ifndef WS_DEQUE_H
+#define WS_DEQUE_H
+
+/******************************************************************************
+* Includes
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+
+/******************************************************************************
+* Preprocessor Constants
+******************************************************************************/
+/**
+ * Number of elements the buffer of a work-stealing deque can hold after
+ * wsdeque_init
+ */
+#define WSDEQUE_INITIAL_CAPACITY    64
+
+/**
+ * Size in bytes of a cache line, used to keep top and bottom apart
+ */
+#define WSDEQUE_CACHE_LINE          64
+
+
+/******************************************************************************
+* Configuration Constants
+******************************************************************************/
+
+
+/******************************************************************************
+* Macros
+******************************************************************************/
+
+
+/******************************************************************************
+* Typedefs
+******************************************************************************/
+/**
+ * Work-stealing deque type definition
+ */
+typedef struct wsdeque_t wsdeque_t;
+/**
+ * Buffer type definition
+ */
+typedef struct wsdeque_buffer_t wsdeque_buffer_t;
+
+/*! @brief Buffer structure definition
+ *
+ *  The slots are made of words that are read and written atomically, so a
+ *  thief can copy an element while the owner writes another slot. The
+ *  element at position i is stored at the slot i & (capacity - 1).
+ */
+struct wsdeque_buffer_t
+{
+    size_t capacity;        /**< Number of slots, a power of two */
+    wsdeque_buffer_t* retired; /**< Buffer replaced by this one */
+    atomic_uintptr_t words[]; /**< Words of the slots */
+};
+
+/*! @brief Work-stealing deque structure definition
+ *
+ *  The owner pushes and pops at bottom and the thieves steal at top. Only
+ *  the owner moves bottom and replaces the buffer, top is only moved with a
+ *  compare and swap.
+ */
+struct wsdeque_t
+{
+    atomic_llong top;       /**< Position of the oldest element */
+    unsigned char padding[WSDEQUE_CACHE_LINE - sizeof(atomic_llong)];
+    atomic_llong bottom;    /**< Position after the newest element */
+    _Atomic(wsdeque_buffer_t*) buffer; /**< Buffer of the elements */
+    size_t dataSize;        /**< Size of data of the elements */
+    size_t slotWords;       /**< Number of words of each slot */
+};
+
+/******************************************************************************
+* Variables
+******************************************************************************/
+
+
+/******************************************************************************
+* Function Prototypes
+******************************************************************************/
+void wsdeque_init(wsdeque_t* deque, size_t dataSize);
+void wsdeque_init_capacity(wsdeque_t* deque, size_t dataSize, size_t capacity);
+void wsdeque_destroy(wsdeque_t* deque);
+void wsdeque_push(wsdeque_t* deque, const void* data);
+uint8_t wsdeque_pop(wsdeque_t* deque, void* data);
+uint8_t wsdeque_steal(wsdeque_t* deque, void* data);
+size_t wsdeque_size(wsdeque_t* deque);
+
+#endif /* WS_DEQUE_H */
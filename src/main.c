@@ -1,44 +1,88 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <unistd.h>
-#include "Linked_list.h"
+#include <pthread.h>
+#include "Ws_deque.h"
 
-void printInt16(const void *data)
+#define NUM_WORKERS     4
+#define RANGE_END       10000000ULL
+#define LEAF_SIZE       10000
+
+typedef struct
 {
-  printf("%d :: ", *(const int16_t *)data);
-}
+    uint64_t begin;
+    uint64_t end;
+} range_t;
 
-void *writeThread(void* arg)
+typedef struct
 {
-    int16_t i;
-    list_t* list = (list_t *) arg;
+    uint32_t id;
+    wsdeque_t tasks;
+    uint64_t total;
+    uint32_t executed;
+    uint32_t stolen;
+} worker_t;
+
+static worker_t workers[NUM_WORKERS];
+static atomic_ullong pending;
+
+// Take a task from the own deque, or from the top of a random victim
+uint8_t nextTask(worker_t* self, range_t* task, unsigned int* seed)
+{
+    uint32_t victim;
+    uint32_t i;
 
-    for (i = 0; i <= 10; i++)
+    if (wsdeque_pop(&(self->tasks), (void *) task) == 0)
       {
-          list_push(list, (void *) &i);
-          sleep(1);
+          return 0;
       }
 
-    pthread_exit(NULL);
+    victim = rand_r(seed) % NUM_WORKERS;
+    for (i = 0; i < NUM_WORKERS; i++, victim = (victim + 1) % NUM_WORKERS)
+      {
+          if (victim != self->id &&
+              wsdeque_steal(&(workers[victim].tasks), (void *) task) == 0)
+            {
+                self->stolen++;
+                return 0;
+            }
+      }
+
+    return 1;
 }
 
-void *readThread(void* arg)
+void *workerThread(void* arg)
 {
-    uint8_t i;
-    int16_t retval;
-    list_t* list = (list_t *) arg;
+    worker_t* self = (worker_t *) arg;
+    unsigned int seed = self->id + 1;
+    range_t task;
+    range_t half;
+    uint64_t i;
 
-    while (list_size(list) == 0)
+    while (atomic_load(&pending) > 0)
       {
-        sleep(1);
-      }
-
-    for (i = 0; i <= 10; i++)
-      {
-          list_pop_front(list, (void *) &retval);
-          printf("%d <- ", retval);
-          list_print(list, printInt16);
-          sleep(2);
+          if (nextTask(self, &task, &seed))
+            {
+                continue;
+            }
+
+          // Split big ranges, the other workers steal the pushed halves
+          while (task.end - task.begin > LEAF_SIZE)
+            {
+                half.begin = task.begin + (task.end - task.begin) / 2;
+                half.end = task.end;
+                task.end = half.begin;
+
+                atomic_fetch_add(&pending, 1);
+                wsdeque_push(&(self->tasks), (void *) &half);
+            }
+
+          for (i = task.begin; i < task.end; i++)
+            {
+                self->total += i;
+            }
+          self->executed++;
+
+          atomic_fetch_sub(&pending, 1);
       }
 
     pthread_exit(NULL);
@@ -46,29 +90,46 @@ void *readThread(void* arg)
 
 int main(int argc, char** argv)
 {
-    pthread_t writer;
-    pthread_t reader;
-    list_t list;
+    pthread_t threads[NUM_WORKERS];
+    range_t all = {0, RANGE_END};
+    uint64_t total = 0;
+    uint32_t i;
 
-    list_init(&list, sizeof(int16_t));
-
-    if (pthread_create(&writer, NULL, writeThread, (void *) &list))
+    for (i = 0; i < NUM_WORKERS; i++)
       {
-          printf("Error creating write thread.\n");
-          exit(EXIT_FAILURE);
+          workers[i].id = i;
+          workers[i].total = 0;
+          workers[i].executed = 0;
+          workers[i].stolen = 0;
+          wsdeque_init(&(workers[i].tasks), sizeof(range_t));
       }
 
-    if (pthread_create(&reader, NULL, readThread, (void *) &list))
+    // The whole range starts in the deque of the first worker
+    atomic_init(&pending, 1);
+    wsdeque_push(&(workers[0].tasks), (void *) &all);
+
+    for (i = 0; i < NUM_WORKERS; i++)
       {
-          printf("Error creating read thread.\n");
-          exit(EXIT_FAILURE);
+          if (pthread_create(&threads[i], NULL, workerThread,
+                             (void *) &workers[i]))
+            {
+                printf("Error creating worker thread.\n");
+                exit(EXIT_FAILURE);
+            }
       }
 
-    pthread_join(writer, NULL);
-    pthread_join(reader, NULL);
+    for (i = 0; i < NUM_WORKERS; i++)
+      {
+          pthread_join(threads[i], NULL);
+          printf("Worker %u: %u tasks, %u stolen\n", i, workers[i].executed,
+                 workers[i].stolen);
+          total += workers[i].total;
+          wsdeque_destroy(&(workers[i].tasks));
+      }
 
-    list_destroy(&list);
+    printf("Sum of 0..%llu: %llu (expected %llu)\n",
+           (unsigned long long) RANGE_END - 1, (unsigned long long) total,
+           (unsigned long long) (RANGE_END * (RANGE_END - 1) / 2));
 
     exit(EXIT_SUCCESS);
 }
-
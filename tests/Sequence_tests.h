@@ -0,0 +1,295 @@
+#ifndef SEQUENCE_TESTS_H
+#define SEQUENCE_TESTS_H
+
+#include <string.h>
+#include "unity.h"
+
+/*
+ * Test bodies shared by the containers with the methods of the linked list
+ * (see Linked_list.h). Each test file fills a sequence_ops_t with wrappers
+ * around its own container, so every container runs the same cases.
+ */
+typedef struct sequence_ops_t
+{
+    void (*init)(size_t dataSize);
+    void (*push)(const void* data);
+    void (*push_front)(const void* data);
+    uint8_t (*pop)(void* data);
+    uint8_t (*pop_front)(void* data);
+    uint8_t (*get_by_index)(size_t index, void* data);
+    void (*for_each)(void (*eachFn)(const void* data, void* arg), void* arg);
+    size_t (*size)(void);
+} sequence_ops_t;
+
+static void
+sequence_sum(const void* data, void* arg)
+{
+    *(int16_t *) arg += *(const int16_t *) data;
+}
+
+static void
+sequence_push_at_back(const sequence_ops_t* ops)
+{
+    const int16_t data[] = {10, 20, 30, 40, 50};
+    int16_t retval;
+    uint8_t error;
+    int i;
+
+    ops->init(sizeof(int16_t));
+
+    for (i = 0; i < 5; i++)
+      {
+          ops->push((void *) &data[i]);
+      }
+
+    for (i = 4; i >= 0; i--)
+      {
+          error = ops->pop((void *) &retval);
+          TEST_ASSERT_EQUAL_INT16(data[i], retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+}
+
+static void
+sequence_push_at_front(const sequence_ops_t* ops)
+{
+    const int16_t data[] = {50, 40, 30, 20, 10};
+    int16_t retval;
+    uint8_t error;
+    int i;
+
+    ops->init(sizeof(int16_t));
+
+    for (i = 0; i < 5; i++)
+      {
+          ops->push_front((void *) &data[i]);
+      }
+
+    for (i = 4; i >= 0; i--)
+      {
+          error = ops->pop_front((void *) &retval);
+          TEST_ASSERT_EQUAL_INT16(data[i], retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+}
+
+static void
+sequence_get_elements(const sequence_ops_t* ops)
+{
+    const int16_t data[] = {10, 20, 30};
+    int16_t retval;
+    uint8_t error;
+    size_t i;
+
+    ops->init(sizeof(int16_t));
+
+    for (i = 0; i < 3; i++)
+      {
+          ops->push((void *) &data[i]);
+      }
+
+    for (i = 0; i < 3; i++)
+      {
+          error = ops->get_by_index(i, (void *) &retval);
+          TEST_ASSERT_EQUAL_INT16(data[i], retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+
+    // An index out of limits leaves the variable as it was
+    error = ops->get_by_index(3, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(30, retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+}
+
+static void
+sequence_return_error_if_empty(const sequence_ops_t* ops, uint8_t front)
+{
+    const int16_t data[] = {10, 20, 30};
+    uint8_t (*popFn)(void* data) = front ? ops->pop_front : ops->pop;
+    int16_t retval;
+    int16_t last;
+    uint8_t error;
+    int i;
+
+    ops->init(sizeof(int16_t));
+
+    for (i = 0; i < 3; i++)
+      {
+          ops->push((void *) &data[i]);
+      }
+
+    for (i = 0; i < 3; i++)
+      {
+          error = popFn((void *) &retval);
+          TEST_ASSERT_EQUAL_INT16(data[front ? i : 2 - i], retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+
+    // An empty container leaves the variable as it was
+    last = retval;
+    error = popFn((void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(last, retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+}
+
+static void
+sequence_behave_as_fifo(const sequence_ops_t* ops)
+{
+    const int16_t data[] = {10, 20, 30};
+    int16_t retval;
+    uint8_t error;
+    int i;
+
+    ops->init(sizeof(int16_t));
+
+    for (i = 0; i < 3; i++)
+      {
+          ops->push((void *) &data[i]);
+      }
+
+    for (i = 0; i < 3; i++)
+      {
+          error = ops->pop_front((void *) &retval);
+          TEST_ASSERT_EQUAL_INT16(data[i], retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+}
+
+static void
+sequence_behave_as_lifo(const sequence_ops_t* ops)
+{
+    const int16_t data[] = {10, 20, 30};
+    int16_t retval;
+    uint8_t error;
+    int i;
+
+    ops->init(sizeof(int16_t));
+
+    for (i = 0; i < 3; i++)
+      {
+          ops->push((void *) &data[i]);
+      }
+
+    for (i = 2; i >= 0; i--)
+      {
+          error = ops->pop((void *) &retval);
+          TEST_ASSERT_EQUAL_INT16(data[i], retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+}
+
+static void
+sequence_work_with_strings(const sequence_ops_t* ops)
+{
+    const char *str[] = {
+        "0x0001",
+        "0x0002",
+        "0x0003",
+    };
+    char retval[7] = {0};
+    uint8_t error;
+    int i;
+
+    ops->init(strlen(str[0]));
+
+    for (i = 0; i < 3; i++)
+      {
+          ops->push((void *) str[i]);
+      }
+
+    for (i = 2; i >= 0; i--)
+      {
+          error = ops->pop((void *) &retval);
+          TEST_ASSERT_EQUAL_STRING(str[i], retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+}
+
+static void
+sequence_iterate_elements(const sequence_ops_t* ops)
+{
+    const int16_t data[] = {10, 20, 30};
+    int16_t retval = 0;
+    int i;
+
+    ops->init(sizeof(int16_t));
+
+    for (i = 0; i < 3; i++)
+      {
+          ops->push((void *) &data[i]);
+      }
+
+    ops->for_each(sequence_sum, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(60, retval);
+}
+
+static void
+sequence_hold_more_than_255_elements(const sequence_ops_t* ops)
+{
+    uint32_t data;
+    uint32_t retval;
+    uint8_t error;
+
+    ops->init(sizeof(uint32_t));
+
+    for (data = 0; data < 300; data++)
+      {
+          ops->push((void *) &data);
+      }
+
+    TEST_ASSERT_EQUAL_UINT32(300, ops->size());
+
+    error = ops->get_by_index(299, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(299, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = ops->get_by_index(300, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+
+    for (data = 299; data > 0; data--)
+      {
+          error = ops->pop((void *) &retval);
+          TEST_ASSERT_EQUAL_UINT32(data, retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+
+    TEST_ASSERT_EQUAL_UINT32(1, ops->size());
+}
+
+static void
+sequence_hold_more_than_65535_elements(const sequence_ops_t* ops)
+{
+    uint32_t data;
+    uint32_t retval;
+    uint8_t error;
+
+    ops->init(sizeof(uint32_t));
+
+    for (data = 0; data < 70000; data++)
+      {
+          ops->push((void *) &data);
+      }
+
+    TEST_ASSERT_EQUAL_UINT32(70000, ops->size());
+
+    error = ops->get_by_index(69999, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(69999, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = ops->get_by_index(70000, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+
+    for (data = 0; data < 70000; data++)
+      {
+          error = ops->pop_front((void *) &retval);
+          TEST_ASSERT_EQUAL_UINT32(data, retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+
+    TEST_ASSERT_EQUAL_UINT32(0, ops->size());
+
+    error = ops->get_by_index(0, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+}
+
+#endif /* SEQUENCE_TESTS_H */
@@ -0,0 +1,252 @@
+#include "unity.h"
+#include "Deque.h"
+#include "Sequence_tests.h"
+
+static deque_t d;
+
+static void
+d_init(size_t dataSize)
+{
+    deque_init(&d, dataSize);
+}
+
+static void
+d_push(const void* data)
+{
+    deque_push(&d, data);
+}
+
+static void
+d_push_front(const void* data)
+{
+    deque_push_front(&d, data);
+}
+
+static uint8_t
+d_pop(void* data)
+{
+    return deque_pop(&d, data);
+}
+
+static uint8_t
+d_pop_front(void* data)
+{
+    return deque_pop_front(&d, data);
+}
+
+static uint8_t
+d_get_by_index(size_t index, void* data)
+{
+    return deque_get_by_index(&d, index, data);
+}
+
+static void
+d_for_each(void (*eachFn)(const void* data, void* arg), void* arg)
+{
+    deque_for_each(&d, eachFn, arg);
+}
+
+static size_t
+d_size(void)
+{
+    return deque_size(&d);
+}
+
+static const sequence_ops_t ops = {
+    d_init, d_push, d_push_front, d_pop, d_pop_front, d_get_by_index,
+    d_for_each, d_size
+};
+
+void
+setUp(void)
+{
+
+}
+
+void
+tearDown(void)
+{
+    deque_destroy(&d);
+}
+
+void
+test_Deque_should_PushAtBack(void)
+{
+    sequence_push_at_back(&ops);
+}
+
+void
+test_Deque_should_PushAtFront(void)
+{
+    sequence_push_at_front(&ops);
+}
+
+void
+test_Deque_should_GetElements(void)
+{
+    sequence_get_elements(&ops);
+}
+
+void
+test_Deque_should_ReturnErrorIfDequeIsEmptyUsingFront(void)
+{
+    sequence_return_error_if_empty(&ops, 1);
+}
+
+void
+test_Deque_should_ReturnErrorIfDequeIsEmptyUsingBack(void)
+{
+    sequence_return_error_if_empty(&ops, 0);
+}
+
+void
+test_Deque_should_BehaveAsFIFO(void)
+{
+    sequence_behave_as_fifo(&ops);
+}
+
+void
+test_Deque_should_BehaveAsLIFO(void)
+{
+    sequence_behave_as_lifo(&ops);
+}
+
+void
+test_Deque_should_WorkWithStrings(void)
+{
+    sequence_work_with_strings(&ops);
+}
+
+void
+test_Deque_should_IterateElements(void)
+{
+    sequence_iterate_elements(&ops);
+}
+
+static void
+collect(const void* data, void* arg)
+{
+    int16_t** out = arg;
+
+    **out = *(const int16_t *) data;
+    (*out)++;
+}
+
+void
+test_Deque_should_IterateInReverse(void)
+{
+    const int16_t data[] = {10, 20, 30};
+    int16_t retval[3];
+    int16_t* out = retval;
+
+    deque_init(&d, sizeof(int16_t));
+
+    deque_push(&d, (void *) &data[1]);
+    deque_push(&d, (void *) &data[2]);
+    deque_push_front(&d, (void *) &data[0]);
+
+    deque_for_each_reverse(&d, collect, (void *) &out);
+    TEST_ASSERT_EQUAL_INT16(30, retval[0]);
+    TEST_ASSERT_EQUAL_INT16(20, retval[1]);
+    TEST_ASSERT_EQUAL_INT16(10, retval[2]);
+}
+
+void
+test_Deque_should_HoldMoreThan255Elements(void)
+{
+    sequence_hold_more_than_255_elements(&ops);
+}
+
+void
+test_Deque_should_HoldMoreThan65535Elements(void)
+{
+    sequence_hold_more_than_65535_elements(&ops);
+}
+
+void
+test_Deque_should_KeepOrderWhenGrowingWrapped(void)
+{
+    int16_t data;
+    int16_t retval;
+    uint8_t error;
+
+    deque_init_capacity(&d, sizeof(int16_t), 4);
+    TEST_ASSERT_EQUAL_UINT32(4, d.capacity);
+
+    // Move the head to the middle of the buffer so the elements wrap
+    for (data = 0; data < 2; data++)
+      {
+          deque_push(&d, (void *) &data);
+          deque_pop_front(&d, (void *) &retval);
+      }
+
+    for (data = 0; data < 4; data++)
+      {
+          deque_push(&d, (void *) &data);
+      }
+    TEST_ASSERT_EQUAL_UINT32(4, d.capacity);
+
+    for (data = 4; data < 10; data++)
+      {
+          deque_push(&d, (void *) &data);
+      }
+    TEST_ASSERT_EQUAL_UINT32(16, d.capacity);
+
+    for (data = 0; data < 10; data++)
+      {
+          error = deque_get_by_index(&d, data, (void *) &retval);
+          TEST_ASSERT_EQUAL_INT16(data, retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+}
+
+void
+test_Deque_should_RoundCapacityToPowerOfTwo(void)
+{
+    deque_init_capacity(&d, sizeof(int16_t), 100);
+    TEST_ASSERT_EQUAL_UINT32(128, d.capacity);
+}
+
+void
+test_Deque_should_BeUsableAfterFree(void)
+{
+    const int16_t data[] = {10, 20};
+    int16_t retval;
+    uint8_t error;
+
+    deque_init(&d, sizeof(int16_t));
+
+    deque_push(&d, (void *) &data[0]);
+    deque_free(&d);
+    TEST_ASSERT_EQUAL_UINT32(0, deque_size(&d));
+
+    error = deque_pop(&d, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+
+    deque_push_front(&d, (void *) &data[1]);
+    error = deque_pop(&d, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+}
+
+int
+main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_Deque_should_PushAtBack);
+    RUN_TEST(test_Deque_should_PushAtFront);
+    RUN_TEST(test_Deque_should_GetElements);
+    RUN_TEST(test_Deque_should_ReturnErrorIfDequeIsEmptyUsingFront);
+    RUN_TEST(test_Deque_should_ReturnErrorIfDequeIsEmptyUsingBack);
+    RUN_TEST(test_Deque_should_BehaveAsFIFO);
+    RUN_TEST(test_Deque_should_BehaveAsLIFO);
+    RUN_TEST(test_Deque_should_WorkWithStrings);
+    RUN_TEST(test_Deque_should_IterateElements);
+    RUN_TEST(test_Deque_should_IterateInReverse);
+    RUN_TEST(test_Deque_should_HoldMoreThan255Elements);
+    RUN_TEST(test_Deque_should_HoldMoreThan65535Elements);
+    RUN_TEST(test_Deque_should_KeepOrderWhenGrowingWrapped);
+    RUN_TEST(test_Deque_should_RoundCapacityToPowerOfTwo);
+    RUN_TEST(test_Deque_should_BeUsableAfterFree);
+    return UNITY_END();
+}
@@ -0,0 +1,245 @@
+#include "unity.h"
+#include "Intrusive_list.h"
+
+#define NUM_ELEMENTS        1000
+
+typedef struct
+{
+    int16_t value;
+    ilist_link_t link;
+    ilist_link_t other;
+} item_t;
+
+static ilist_t l;
+static item_t items[NUM_ELEMENTS];
+
+void
+setUp(void)
+{
+    int16_t i;
+
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          items[i].value = i;
+      }
+    ilist_init(&l);
+}
+
+void
+tearDown(void)
+{
+    ilist_destroy(&l);
+}
+
+void sum(ilist_link_t* link, void* arg)
+{
+    *(int32_t *) arg += ILIST_ENTRY(link, item_t, link)->value;
+}
+
+void
+test_IntrusiveList_should_PushAtBack(void)
+{
+    ilist_link_t* link;
+
+    ilist_push(&l, &items[10].link);
+    ilist_push(&l, &items[20].link);
+    ilist_push(&l, &items[30].link);
+
+    link = ilist_pop(&l);
+    TEST_ASSERT_EQUAL_PTR(&items[30], ILIST_ENTRY(link, item_t, link));
+
+    link = ilist_pop(&l);
+    TEST_ASSERT_EQUAL_PTR(&items[20], ILIST_ENTRY(link, item_t, link));
+
+    link = ilist_pop(&l);
+    TEST_ASSERT_EQUAL_PTR(&items[10], ILIST_ENTRY(link, item_t, link));
+
+    TEST_ASSERT_NULL(ilist_pop(&l));
+}
+
+void
+test_IntrusiveList_should_PushAtFront(void)
+{
+    ilist_link_t* link;
+
+    ilist_push_front(&l, &items[30].link);
+    ilist_push_front(&l, &items[20].link);
+    ilist_push_front(&l, &items[10].link);
+
+    link = ilist_pop_front(&l);
+    TEST_ASSERT_EQUAL_INT16(10, ILIST_ENTRY(link, item_t, link)->value);
+
+    link = ilist_pop_front(&l);
+    TEST_ASSERT_EQUAL_INT16(20, ILIST_ENTRY(link, item_t, link)->value);
+
+    link = ilist_pop_front(&l);
+    TEST_ASSERT_EQUAL_INT16(30, ILIST_ENTRY(link, item_t, link)->value);
+
+    TEST_ASSERT_NULL(ilist_pop_front(&l));
+}
+
+void
+test_IntrusiveList_should_BehaveAsFIFO(void)
+{
+    ilist_link_t* link;
+    int16_t i;
+
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          ilist_push(&l, &items[i].link);
+      }
+    TEST_ASSERT_EQUAL_UINT32(NUM_ELEMENTS, ilist_size(&l));
+
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          link = ilist_pop_front(&l);
+          TEST_ASSERT_EQUAL_INT16(i, ILIST_ENTRY(link, item_t, link)->value);
+      }
+
+    TEST_ASSERT_EQUAL_UINT32(0, ilist_size(&l));
+}
+
+void
+test_IntrusiveList_should_RemoveFromAnyPosition(void)
+{
+    ilist_link_t* link;
+
+    ilist_push(&l, &items[1].link);
+    ilist_push(&l, &items[2].link);
+    ilist_push(&l, &items[3].link);
+    ilist_push(&l, &items[4].link);
+
+    // Middle, front and back
+    ilist_remove(&l, &items[2].link);
+    ilist_remove(&l, &items[1].link);
+    ilist_remove(&l, &items[4].link);
+    TEST_ASSERT_EQUAL_UINT32(1, ilist_size(&l));
+
+    link = ilist_pop(&l);
+    TEST_ASSERT_EQUAL_INT16(3, ILIST_ENTRY(link, item_t, link)->value);
+    TEST_ASSERT_NULL(ilist_pop(&l));
+
+    // The removed objects can be linked again
+    ilist_push(&l, &items[2].link);
+    ilist_push_front(&l, &items[4].link);
+
+    link = ilist_pop_front(&l);
+    TEST_ASSERT_EQUAL_INT16(4, ILIST_ENTRY(link, item_t, link)->value);
+    link = ilist_pop_front(&l);
+    TEST_ASSERT_EQUAL_INT16(2, ILIST_ENTRY(link, item_t, link)->value);
+}
+
+void
+test_IntrusiveList_should_RejectRemovingUnlinkedElements(void)
+{
+    ilist_t other;
+    ilist_link_t* link;
+
+    ilist_init(&other);
+
+    ilist_push(&l, &items[1].link);
+    ilist_push(&l, &items[2].link);
+    ilist_push(&other, &items[3].link);
+
+    TEST_ASSERT_EQUAL_UINT8(0, ilist_remove(&l, &items[2].link));
+
+    // Removed twice, popped, or the first element of another list
+    TEST_ASSERT_EQUAL_UINT8(1, ilist_remove(&l, &items[2].link));
+    link = ilist_pop(&l);
+    TEST_ASSERT_EQUAL_PTR(&items[1].link, link);
+    TEST_ASSERT_EQUAL_UINT8(1, ilist_remove(&l, &items[1].link));
+    TEST_ASSERT_EQUAL_UINT8(1, ilist_remove(&l, &items[3].link));
+
+    TEST_ASSERT_EQUAL_UINT32(0, ilist_size(&l));
+    TEST_ASSERT_EQUAL_UINT32(1, ilist_size(&other));
+
+    // The list still works after the rejected removals
+    ilist_push(&l, &items[4].link);
+    link = ilist_pop_front(&l);
+    TEST_ASSERT_EQUAL_PTR(&items[4].link, link);
+    TEST_ASSERT_NULL(ilist_pop_front(&l));
+
+    ilist_destroy(&other);
+}
+
+void
+test_IntrusiveList_should_IterateElements(void)
+{
+    int16_t i;
+    int32_t total = 0;
+
+    for (i = 0; i < NUM_ELEMENTS; i++)
+      {
+          ilist_push(&l, &items[i].link);
+      }
+
+    ilist_for_each(&l, sum, (void *) &total);
+    TEST_ASSERT_EQUAL_INT32(NUM_ELEMENTS * (NUM_ELEMENTS - 1) / 2, total);
+}
+
+void
+test_IntrusiveList_should_LinkAnObjectInTwoLists(void)
+{
+    ilist_t odd;
+    ilist_link_t* link;
+    int16_t i;
+
+    ilist_init(&odd);
+
+    for (i = 0; i < 10; i++)
+      {
+          ilist_push(&l, &items[i].link);
+          if (i % 2 == 1)
+            {
+                ilist_push_front(&odd, &items[i].other);
+            }
+      }
+
+    // Unlinking from one list doesn't touch the other one
+    ilist_remove(&l, &items[5].link);
+    TEST_ASSERT_EQUAL_UINT32(9, ilist_size(&l));
+    TEST_ASSERT_EQUAL_UINT32(5, ilist_size(&odd));
+
+    for (i = 9; i >= 1; i -= 2)
+      {
+          link = ilist_pop_front(&odd);
+          TEST_ASSERT_EQUAL_PTR(&items[i], ILIST_ENTRY(link, item_t, other));
+      }
+
+    ilist_destroy(&odd);
+}
+
+void
+test_IntrusiveList_should_ClearWithoutTouchingObjects(void)
+{
+    int16_t i;
+
+    for (i = 0; i < 10; i++)
+      {
+          ilist_push(&l, &items[i].link);
+      }
+
+    ilist_clear(&l);
+    TEST_ASSERT_EQUAL_UINT32(0, ilist_size(&l));
+    TEST_ASSERT_NULL(ilist_pop(&l));
+    TEST_ASSERT_NULL(items[0].link.next);
+    TEST_ASSERT_EQUAL_INT16(9, items[9].value);
+
+    ilist_push(&l, &items[9].link);
+    TEST_ASSERT_EQUAL_UINT32(1, ilist_size(&l));
+}
+
+int
+main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_IntrusiveList_should_PushAtBack);
+    RUN_TEST(test_IntrusiveList_should_PushAtFront);
+    RUN_TEST(test_IntrusiveList_should_BehaveAsFIFO);
+    RUN_TEST(test_IntrusiveList_should_RemoveFromAnyPosition);
+    RUN_TEST(test_IntrusiveList_should_RejectRemovingUnlinkedElements);
+    RUN_TEST(test_IntrusiveList_should_IterateElements);
+    RUN_TEST(test_IntrusiveList_should_LinkAnObjectInTwoLists);
+    RUN_TEST(test_IntrusiveList_should_ClearWithoutTouchingObjects);
+    return UNITY_END();
+}
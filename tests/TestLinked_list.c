@@ -1,12 +1,76 @@
+#include <unistd.h>
 #include "unity.h"
 #include "Linked_list.h"
+#include "Sequence_tests.h"
+
+#define NUM_PRODUCERS       4
+#define NUM_ITEMS           10000
+#define NUM_READERS         2
 
 static list_t l;
+static atomic_uint numReading;
+static uint32_t listFlags;
+
+static void
+l_init(size_t dataSize)
+{
+    list_config_t config = {0};
+
+    config.flags = listFlags;
+    list_init_config(&l, dataSize, &config);
+}
+
+static void
+l_push(const void* data)
+{
+    list_push(&l, data);
+}
+
+static void
+l_push_front(const void* data)
+{
+    list_push_front(&l, data);
+}
+
+static uint8_t
+l_pop(void* data)
+{
+    return list_pop(&l, data);
+}
+
+static uint8_t
+l_pop_front(void* data)
+{
+    return list_pop_front(&l, data);
+}
+
+static uint8_t
+l_get_by_index(size_t index, void* data)
+{
+    return list_get_by_index(&l, index, data);
+}
+
+static void
+l_for_each(void (*eachFn)(const void* data, void* arg), void* arg)
+{
+    list_for_each(&l, eachFn, arg);
+}
+
+static size_t
+l_size(void)
+{
+    return list_size(&l);
+}
+
+static const sequence_ops_t ops = {
+    l_init, l_push, l_push_front, l_pop, l_pop_front, l_get_by_index,
+    l_for_each, l_size
+};
 
 void
 setUp(void)
 {
-    
+    listFlags = 0;
 }
 
 void
@@ -18,268 +82,2321 @@ tearDown(void)
 void
 test_LinkedList_should_PushAtBack(void)
 {
-    const int16_t data[] = {10, 20, 30, 40, 50};
-    int16_t retval;
-    uint8_t error;
-
-    list_init(&l, sizeof(int16_t));
-
-    list_push(&l, (void *) &data[0]);
-    list_push(&l, (void *) &data[1]);
-    list_push(&l, (void *) &data[2]);
-    list_push(&l, (void *) &data[3]);
-    list_push(&l, (void *) &data[4]);
+    sequence_push_at_back(&ops);
+}
 
-    error = list_pop(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(50, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+void
+test_LinkedList_should_PushAtFront(void)
+{
+    sequence_push_at_front(&ops);
+}
 
-    error = list_pop(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(40, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+void
+test_LinkedList_should_GetElements(void)
+{
+    sequence_get_elements(&ops);
+}
 
-    error = list_pop(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(30, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+void
+test_LinkedList_should_ReturnErrorIfListIsEmptyUsingFront(void)
+{
+    sequence_return_error_if_empty(&ops, 1);
+}
 
-    error = list_pop(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(20, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+void
+test_LinkedList_should_ReturnErrorIfListIsEmptyUsingBack(void)
+{
+    sequence_return_error_if_empty(&ops, 0);
+}
 
-    error = list_pop(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(10, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+void
+test_LinkedList_should_BehaveAsFIFO(void)
+{
+    sequence_behave_as_fifo(&ops);
 }
 
 void
-test_LinkedList_should_PushAtFront(void)
+test_LinkedList_should_BehaveAsLIFO(void)
 {
-    const int16_t data[] = {50, 40, 30, 20, 10};
-    int16_t retval;
-    uint8_t error;
+    sequence_behave_as_lifo(&ops);
+}
 
-    list_init(&l, sizeof(int16_t));
+void
+test_LinkedList_should_WorkWithStrings(void)
+{
+    sequence_work_with_strings(&ops);
+}
 
-    list_push_front(&l, (void *) &data[0]);
-    list_push_front(&l, (void *) &data[1]);
-    list_push_front(&l, (void *) &data[2]);
-    list_push_front(&l, (void *) &data[3]);
-    list_push_front(&l, (void *) &data[4]);
+static void
+sum(const void* data, void* arg)
+{
+    *(int16_t *) arg += *(int16_t *) data;
+}
 
-    error = list_pop_front(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(10, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+void
+test_LinkedList_should_IterateElements(void)
+{
+    sequence_iterate_elements(&ops);
+}
 
-    error = list_pop_front(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(20, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+void
+test_LinkedList_should_ReuseNodesFromPool(void)
+{
+    int16_t data;
+    int16_t retval;
+    list_pool_info_t info;
 
-    error = list_pop_front(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(30, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+    list_init_pooled(&l, sizeof(int16_t), 4);
 
-    error = list_pop_front(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(40, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+    for (data = 0; data < 100; data++)
+      {
+          list_push(&l, (void *) &data);
+          list_pop_front(&l, (void *) &retval);
+          TEST_ASSERT_EQUAL_INT16(data, retval);
+      }
 
-    error = list_pop_front(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(50, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+    list_pool_info(&l, &info);
+    TEST_ASSERT_EQUAL_UINT32(1, info.numChunks);
+    TEST_ASSERT_EQUAL_UINT32(4, info.numNodes);
+    TEST_ASSERT_EQUAL_UINT32(4, info.numFreeNodes);
 }
 
 void
-test_LinkedList_should_GetElements(void)
+test_LinkedList_should_GrowAndReleasePoolChunks(void)
 {
-    const int16_t data[] = {10, 20, 30};
+    int16_t data;
     int16_t retval;
-    uint8_t error;
+    list_pool_info_t info;
 
-    list_init(&l, sizeof(int16_t));
+    list_init_pooled(&l, sizeof(int16_t), 4);
 
-    list_push(&l, (void *) &data[0]);
-    list_push(&l, (void *) &data[1]);
-    list_push(&l, (void *) &data[2]);
+    for (data = 0; data < 10; data++)
+      {
+          list_push(&l, (void *) &data);
+      }
 
-    error = list_get_by_index(&l, 0, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(10, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+    list_pool_info(&l, &info);
+    TEST_ASSERT_EQUAL_UINT32(3, info.numChunks);
+    TEST_ASSERT_EQUAL_UINT32(2, info.numFreeNodes);
 
-    error = list_get_by_index(&l, 1, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(20, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+    list_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(9, retval);
+    list_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(0, retval);
 
-    error = list_get_by_index(&l, 2, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(30, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
-    
-    error = list_get_by_index(&l, 3, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(30, retval);
-    TEST_ASSERT_EQUAL_UINT8(1, error);
+    list_pool_info(&l, &info);
+    TEST_ASSERT_EQUAL_UINT32(4, info.numFreeNodes);
+
+    list_free(&l);
+    list_pool_info(&l, &info);
+    TEST_ASSERT_EQUAL_UINT32(0, info.numChunks);
+    TEST_ASSERT_EQUAL_UINT32(0, list_size(&l));
+}
+
+static void
+collect(const void* data, void* arg)
+{
+    int16_t** out = (int16_t **) arg;
+
+    **out = *(const int16_t *) data;
+    (*out)++;
 }
 
 void
-test_LinkedList_should_ReturnErrorIfListIsEmptyUsingFront(void)
+test_LinkedList_should_PopAtBackWhenDoublyLinked(void)
 {
-    const int16_t data[] = {10, 20, 30};
+    const int16_t data[] = {10, 20, 30, 40};
     int16_t retval;
     uint8_t error;
+    list_config_t config = {0};
 
-    list_init(&l, sizeof(int16_t));
+    config.flags = LIST_DOUBLY_LINKED;
+    list_init_config(&l, sizeof(int16_t), &config);
 
-    list_push(&l, (void *) &data[0]);
     list_push(&l, (void *) &data[1]);
     list_push(&l, (void *) &data[2]);
+    list_push_front(&l, (void *) &data[0]);
+    list_push(&l, (void *) &data[3]);
 
-    error = list_pop_front(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(10, retval);
+    error = list_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(40, retval);
     TEST_ASSERT_EQUAL_UINT8(0, error);
 
     error = list_pop_front(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(20, retval);
+    TEST_ASSERT_EQUAL_INT16(10, retval);
     TEST_ASSERT_EQUAL_UINT8(0, error);
 
-    error = list_pop_front(&l, (void *) &retval);
+    error = list_pop(&l, (void *) &retval);
     TEST_ASSERT_EQUAL_INT16(30, retval);
     TEST_ASSERT_EQUAL_UINT8(0, error);
 
-    error = list_pop_front(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(30, retval);
+    error = list_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = list_pop(&l, (void *) &retval);
     TEST_ASSERT_EQUAL_UINT8(1, error);
 }
 
 void
-test_LinkedList_should_ReturnErrorIfListIsEmptyUsingBack(void)
+test_LinkedList_should_IterateInReverseWhenDoublyLinked(void)
 {
     const int16_t data[] = {10, 20, 30};
-    int16_t retval;
+    int16_t retval[3] = {0};
+    int16_t* out = retval;
     uint8_t error;
+    list_config_t config = {0};
 
-    list_init(&l, sizeof(int16_t));
+    config.flags = LIST_DOUBLY_LINKED;
+    config.nodesPerChunk = 2;
+    list_init_config(&l, sizeof(int16_t), &config);
 
     list_push(&l, (void *) &data[0]);
     list_push(&l, (void *) &data[1]);
     list_push(&l, (void *) &data[2]);
 
-    error = list_pop(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(30, retval);
+    error = list_for_each_reverse(&l, collect, (void *) &out);
     TEST_ASSERT_EQUAL_UINT8(0, error);
+    TEST_ASSERT_EQUAL_INT16(30, retval[0]);
+    TEST_ASSERT_EQUAL_INT16(20, retval[1]);
+    TEST_ASSERT_EQUAL_INT16(10, retval[2]);
+}
 
-    error = list_pop(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(20, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+void
+test_LinkedList_should_NotIterateInReverseWhenSinglyLinked(void)
+{
+    int16_t retval = 0;
+    uint8_t error;
 
-    error = list_pop(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(10, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+    list_init(&l, sizeof(int16_t));
 
-    error = list_pop(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(10, retval);
+    error = list_for_each_reverse(&l, sum, (void *) &retval);
     TEST_ASSERT_EQUAL_UINT8(1, error);
 }
 
 void
-test_LinkedList_should_BehaveAsFIFO(void)
+test_LinkedList_should_HoldMoreThan255Elements(void)
 {
-    const int16_t data[] = {10, 20, 30};
-    int16_t retval;
-    uint8_t error;
+    sequence_hold_more_than_255_elements(&ops);
+}
 
-    list_init(&l, sizeof(int16_t));
+void
+test_LinkedList_should_HoldMoreThan65535Elements(void)
+{
+    listFlags = LIST_DOUBLY_LINKED;
+    sequence_hold_more_than_65535_elements(&ops);
+}
 
-    list_push(&l, (void *) &data[0]);
-    list_push(&l, (void *) &data[1]);
-    list_push(&l, (void *) &data[2]);
+static void*
+producer(void* arg)
+{
+    uint32_t i;
+    uint32_t id = (uint32_t) (uintptr_t) arg;
+    uint32_t data;
 
-    error = list_pop_front(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(10, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+    for (i = 0; i < NUM_ITEMS; i++)
+      {
+          data = (id << 24) | i;
+          list_push(&l, (void *) &data);
+      }
 
-    error = list_pop_front(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(20, retval);
+    return NULL;
+}
+
+static void
+run_producers_and_consumer(uint32_t flags, size_t capacity)
+{
+    pthread_t threads[NUM_PRODUCERS];
+    uint32_t next[NUM_PRODUCERS] = {0};
+    uint32_t retval;
+    uint32_t received = 0;
+    uintptr_t i;
+    uint8_t error;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    config.capacity = capacity;
+    error = list_init_config(&l, sizeof(uint32_t), &config);
     TEST_ASSERT_EQUAL_UINT8(0, error);
 
+    for (i = 0; i < NUM_PRODUCERS; i++)
+      {
+          pthread_create(&threads[i], NULL, producer, (void *) i);
+      }
+
+    while (received < NUM_PRODUCERS * NUM_ITEMS)
+      {
+          if (list_pop_front(&l, (void *) &retval) == 0)
+            {
+                TEST_ASSERT_EQUAL_UINT32(next[retval >> 24], retval & 0xFFFFFF);
+                next[retval >> 24]++;
+                received++;
+            }
+      }
+
+    for (i = 0; i < NUM_PRODUCERS; i++)
+      {
+          pthread_join(threads[i], NULL);
+      }
+
+    TEST_ASSERT_EQUAL_UINT32(0, list_size(&l));
     error = list_pop_front(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(30, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
 }
 
 void
-test_LinkedList_should_BehaveAsLIFO(void)
+test_LinkedList_should_KeepProducerOrderWhenMPSC(void)
+{
+    run_producers_and_consumer(LIST_MPSC, 0);
+}
+
+void
+test_LinkedList_should_KeepProducerOrderWhenTwoLock(void)
+{
+    run_producers_and_consumer(LIST_TWO_LOCK, 0);
+}
+
+static void
+push_and_pop_both_ends(uint32_t flags)
 {
     const int16_t data[] = {10, 20, 30};
     int16_t retval;
     uint8_t error;
+    list_config_t config = {0};
 
-    list_init(&l, sizeof(int16_t));
+    config.flags = flags;
+    list_init_config(&l, sizeof(int16_t), &config);
 
-    list_push(&l, (void *) &data[0]);
-    list_push(&l, (void *) &data[1]);
+    list_push_front(&l, (void *) &data[1]);
     list_push(&l, (void *) &data[2]);
+    list_push_front(&l, (void *) &data[0]);
 
-    error = list_pop(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(30, retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
-
-    error = list_pop(&l, (void *) &retval);
+    error = list_get_by_index(&l, 1, (void *) &retval);
     TEST_ASSERT_EQUAL_INT16(20, retval);
     TEST_ASSERT_EQUAL_UINT8(0, error);
 
     error = list_pop(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_INT16(10, retval);
+    TEST_ASSERT_EQUAL_INT16(30, retval);
     TEST_ASSERT_EQUAL_UINT8(0, error);
-}
-
-void
-test_LinkedList_should_WorkWithStrings(void)
-{
-    const char *str[] = {
-        "0x0001",
-        "0x0002",
-        "0x0003",
-    };
-    char retval[7];
-    uint8_t error;
 
-    list_init(&l, strlen(str[0]));
+    list_push(&l, (void *) &data[2]);
 
-    list_push(&l, (void *) str[0]);
-    list_push(&l, (void *) str[1]);
-    list_push(&l, (void *) str[2]);
+    error = list_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(10, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
 
     error = list_pop(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_STRING("0x0003", retval);
+    TEST_ASSERT_EQUAL_INT16(30, retval);
     TEST_ASSERT_EQUAL_UINT8(0, error);
 
     error = list_pop(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_STRING("0x0002", retval);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
     TEST_ASSERT_EQUAL_UINT8(0, error);
 
     error = list_pop(&l, (void *) &retval);
-    TEST_ASSERT_EQUAL_STRING("0x0001", retval);
-    TEST_ASSERT_EQUAL_UINT8(0, error);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+    TEST_ASSERT_EQUAL_UINT32(0, list_size(&l));
 }
 
-void sum(const void* data, void* arg)
+void
+test_LinkedList_should_PushAndPopBothEndsWhenMPSC(void)
 {
-    *(int16_t *) arg += *(int16_t *) data;
+    push_and_pop_both_ends(LIST_MPSC);
 }
 
 void
-test_LinkedList_should_IterateElements(void)
+test_LinkedList_should_PushAndPopBothEndsWhenTwoLock(void)
+{
+    push_and_pop_both_ends(LIST_TWO_LOCK);
+}
+
+void
+test_LinkedList_should_RejectInvalidConcurrentConfig(void)
 {
-    const int16_t data[] = {10, 20, 30};
-    int16_t retval = 0;
     uint8_t error;
+    list_config_t config = {0};
 
-    list_init(&l, sizeof(int16_t));
+    config.flags = LIST_MPSC | LIST_DOUBLY_LINKED;
+    error = list_init_config(&l, sizeof(int16_t), &config);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
 
-    list_push(&l, (void *) &data[0]);
-    list_push(&l, (void *) &data[1]);
-    list_push(&l, (void *) &data[2]);
+    config.flags = LIST_MPSC;
+    config.nodesPerChunk = 16;
+    error = list_init_config(&l, sizeof(int16_t), &config);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
 
-    list_for_each(&l, sum, (void*) &retval);
-    TEST_ASSERT_EQUAL_INT16(60, retval);
+    config.flags = LIST_MPSC | LIST_TWO_LOCK;
+    config.nodesPerChunk = 0;
+    error = list_init_config(&l, sizeof(int16_t), &config);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+
+    config.flags = LIST_TWO_LOCK | LIST_DOUBLY_LINKED;
+    error = list_init_config(&l, sizeof(int16_t), &config);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+
+    config.flags = LIST_MPSC;
+    config.capacity = 16;
+    config.overflowPolicy = LIST_OVERFLOW_DROP_OLDEST;
+    error = list_init_config(&l, sizeof(int16_t), &config);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+
+    list_init(&l, sizeof(int16_t));
+}
+
+static void*
+delayed_producer(void* arg)
+{
+    int16_t data = 42;
+
+    usleep(20000);
+    list_push(&l, (void *) &data);
+
+    return NULL;
+}
+
+static void*
+delayed_close(void* arg)
+{
+    usleep(20000);
+    list_close(&l);
+
+    return NULL;
+}
+
+static void
+wait_for_push(uint32_t flags)
+{
+    pthread_t thread;
+    int16_t retval = 0;
+    uint8_t error;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    list_init_config(&l, sizeof(int16_t), &config);
+
+    pthread_create(&thread, NULL, delayed_producer, NULL);
+
+    error = list_pop_front_wait(&l, (void *) &retval, LIST_WAIT_FOREVER);
+    TEST_ASSERT_EQUAL_INT16(42, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    pthread_join(thread, NULL);
+}
+
+void
+test_LinkedList_should_WaitForPush(void)
+{
+    wait_for_push(0);
+}
+
+void
+test_LinkedList_should_WaitForPushWhenMPSC(void)
+{
+    wait_for_push(LIST_MPSC);
+}
+
+void
+test_LinkedList_should_WaitForPushWhenTwoLock(void)
+{
+    wait_for_push(LIST_TWO_LOCK);
+}
+
+void
+test_LinkedList_should_TimeoutWaitingOnEmptyList(void)
+{
+    int16_t retval;
+    uint8_t error;
+
+    list_init(&l, sizeof(int16_t));
+
+    error = list_pop_front_wait(&l, (void *) &retval, 10);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+
+    error = list_pop_wait(&l, (void *) &retval, 0);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+}
+
+void
+test_LinkedList_should_WakeWaitersWhenClosed(void)
+{
+    const int16_t data[] = {10, 20};
+    pthread_t thread;
+    int16_t retval;
+    uint8_t error;
+
+    list_init(&l, sizeof(int16_t));
+
+    pthread_create(&thread, NULL, delayed_close, NULL);
+
+    error = list_pop_wait(&l, (void *) &retval, LIST_WAIT_FOREVER);
+    TEST_ASSERT_EQUAL_UINT8(2, error);
+
+    pthread_join(thread, NULL);
+
+    // Elements pushed after closing can still be drained
+    list_push(&l, (void *) &data[0]);
+    list_push(&l, (void *) &data[1]);
+
+    error = list_pop_wait(&l, (void *) &retval, LIST_WAIT_FOREVER);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = list_pop_front_wait(&l, (void *) &retval, LIST_WAIT_FOREVER);
+    TEST_ASSERT_EQUAL_INT16(10, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = list_pop_front_wait(&l, (void *) &retval, LIST_WAIT_FOREVER);
+    TEST_ASSERT_EQUAL_UINT8(2, error);
+}
+
+static void
+bounded_try_push(uint32_t flags)
+{
+    const int16_t data[] = {10, 20, 30};
+    int16_t retval;
+    uint8_t error;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    config.capacity = 2;
+    list_init_config(&l, sizeof(int16_t), &config);
+
+    TEST_ASSERT_EQUAL_UINT8(0, list_try_push(&l, (void *) &data[0]));
+    TEST_ASSERT_EQUAL_UINT8(0, list_try_push(&l, (void *) &data[1]));
+    TEST_ASSERT_EQUAL_UINT8(1, list_try_push(&l, (void *) &data[2]));
+    TEST_ASSERT_EQUAL_UINT8(1, list_push_wait(&l, (void *) &data[2], 10));
+    TEST_ASSERT_EQUAL_UINT32(2, list_size(&l));
+
+    // Popping makes room for one more element
+    error = list_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(10, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+    TEST_ASSERT_EQUAL_UINT8(0, list_try_push(&l, (void *) &data[2]));
+
+    list_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
+    list_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(30, retval);
+}
+
+void
+test_LinkedList_should_RejectPushWhenFull(void)
+{
+    bounded_try_push(0);
+}
+
+void
+test_LinkedList_should_RejectPushWhenFullAndMPSC(void)
+{
+    bounded_try_push(LIST_MPSC);
+}
+
+static void
+drop_oldest(uint32_t flags)
+{
+    const int16_t data[] = {10, 20, 30, 40};
+    int16_t retval;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    config.capacity = 2;
+    config.overflowPolicy = LIST_OVERFLOW_DROP_OLDEST;
+    list_init_config(&l, sizeof(int16_t), &config);
+
+    list_push(&l, (void *) &data[0]);
+    list_push(&l, (void *) &data[1]);
+    list_push(&l, (void *) &data[2]);
+    TEST_ASSERT_EQUAL_UINT32(2, list_size(&l));
+
+    // Pushing at the front drops the element at the end
+    list_push_front(&l, (void *) &data[3]);
+    TEST_ASSERT_EQUAL_UINT32(2, list_size(&l));
+
+    list_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(40, retval);
+    list_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
+}
+
+void
+test_LinkedList_should_DropOldestWhenFull(void)
+{
+    drop_oldest(0);
+}
+
+void
+test_LinkedList_should_DropOldestWhenFullAndTwoLock(void)
+{
+    drop_oldest(LIST_TWO_LOCK);
+}
+
+static void*
+delayed_consumer(void* arg)
+{
+    int16_t data;
+
+    usleep(20000);
+    list_pop_front(&l, (void *) &data);
+
+    return NULL;
+}
+
+void
+test_LinkedList_should_WaitForRoomWhenFull(void)
+{
+    const int16_t data[] = {10, 20};
+    pthread_t thread;
+    int16_t retval;
+    uint8_t error;
+    list_config_t config = {0};
+
+    config.capacity = 1;
+    list_init_config(&l, sizeof(int16_t), &config);
+
+    list_push(&l, (void *) &data[0]);
+
+    pthread_create(&thread, NULL, delayed_consumer, NULL);
+
+    error = list_push_wait(&l, (void *) &data[1], LIST_WAIT_FOREVER);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    pthread_join(thread, NULL);
+
+    list_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
+
+    // A closed list doesn't wait for room anymore
+    list_push(&l, (void *) &data[0]);
+    list_close(&l);
+    error = list_push_wait(&l, (void *) &data[1], LIST_WAIT_FOREVER);
+    TEST_ASSERT_EQUAL_UINT8(2, error);
+}
+
+static atomic_uint numTimeouts;
+
+static void*
+blocking_producer(void* arg)
+{
+    uint32_t i;
+
+    (void) arg;
+
+    for (i = 0; i < NUM_ITEMS; i++)
+      {
+          if (list_push_wait(&l, (void *) &i, 2000) != 0)
+            {
+                atomic_fetch_add(&numTimeouts, 1);
+            }
+      }
+
+    return NULL;
+}
+
+static void
+hand_off_blocking(uint32_t flags)
+{
+    pthread_t thread;
+    uint32_t retval;
+    uint32_t i;
+    uint8_t error;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    config.capacity = 1;
+    list_init_config(&l, sizeof(uint32_t), &config);
+    atomic_store(&numTimeouts, 0);
+
+    pthread_create(&thread, NULL, blocking_producer, NULL);
+
+    // Both threads keep waiting on each other, the list never holds more 
+    // than one element
+    for (i = 0; i < NUM_ITEMS; i++)
+      {
+          error = list_pop_front_wait(&l, (void *) &retval, 2000);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+          TEST_ASSERT_EQUAL_UINT32(i, retval);
+      }
+
+    pthread_join(thread, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, atomic_load(&numTimeouts));
+}
+
+void
+test_LinkedList_should_HandOffBetweenBlockedProducerAndConsumer(void)
+{
+    const uint32_t modes[] = {0, LIST_DOUBLY_LINKED, LIST_MPSC, 
+                              LIST_TWO_LOCK, LIST_RWLOCK};
+    size_t i;
+
+    for (i = 0; i < sizeof(modes) / sizeof(modes[0]); i++)
+      {
+          // The list of the last mode is destroyed by tearDown
+          if (i > 0)
+            {
+                list_destroy(&l);
+            }
+          hand_off_blocking(modes[i]);
+      }
+}
+
+void
+test_LinkedList_should_KeepProducerOrderWhenBoundedMPSC(void)
+{
+    run_producers_and_consumer(LIST_MPSC, 16);
+}
+
+void
+test_LinkedList_should_KeepProducerOrderWhenBoundedTwoLock(void)
+{
+    run_producers_and_consumer(LIST_TWO_LOCK, 16);
+}
+
+static void
+batch_push_and_pop(uint32_t flags, size_t nodesPerChunk)
+{
+    uint32_t data[100];
+    uint32_t retval[64];
+    uint32_t i;
+    size_t count;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    config.nodesPerChunk = nodesPerChunk;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    for (i = 0; i < 100; i++)
+      {
+          data[i] = i;
+      }
+
+    count = list_push_n(&l, (void *) data, 100);
+    TEST_ASSERT_EQUAL_UINT32(100, count);
+    TEST_ASSERT_EQUAL_UINT32(100, list_size(&l));
+
+    count = list_pop_front_n(&l, (void *) retval, 64);
+    TEST_ASSERT_EQUAL_UINT32(64, count);
+    for (i = 0; i < 64; i++)
+      {
+          TEST_ASSERT_EQUAL_UINT32(i, retval[i]);
+      }
+
+    // The batch keeps working with single pushes and pops
+    list_push(&l, (void *) &data[0]);
+    list_pop(&l, (void *) &retval[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, retval[0]);
+
+    count = list_pop_front_n(&l, (void *) retval, 64);
+    TEST_ASSERT_EQUAL_UINT32(36, count);
+    for (i = 0; i < 36; i++)
+      {
+          TEST_ASSERT_EQUAL_UINT32(64 + i, retval[i]);
+      }
+
+    count = list_pop_front_n(&l, (void *) retval, 64);
+    TEST_ASSERT_EQUAL_UINT32(0, count);
+    TEST_ASSERT_EQUAL_UINT32(0, list_size(&l));
+
+    list_push_n(&l, (void *) data, 3);
+    list_pop(&l, (void *) &retval[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, retval[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, list_size(&l));
+}
+
+void
+test_LinkedList_should_PushAndPopInBatches(void)
+{
+    batch_push_and_pop(0, 0);
+}
+
+void
+test_LinkedList_should_PushAndPopInBatchesWhenDoublyLinked(void)
+{
+    batch_push_and_pop(LIST_DOUBLY_LINKED, 0);
+}
+
+void
+test_LinkedList_should_PushAndPopInBatchesWithPool(void)
+{
+    batch_push_and_pop(0, 16);
+}
+
+void
+test_LinkedList_should_PushAndPopInBatchesWhenMPSC(void)
+{
+    batch_push_and_pop(LIST_MPSC, 0);
+}
+
+void
+test_LinkedList_should_PushAndPopInBatchesWhenTwoLock(void)
+{
+    batch_push_and_pop(LIST_TWO_LOCK, 0);
+}
+
+static void
+batch_push_when_full(uint32_t flags, uint8_t overflowPolicy)
+{
+    const uint32_t data[] = {10, 20, 30, 40, 50};
+    uint32_t retval[4];
+    size_t count;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    config.capacity = 4;
+    config.overflowPolicy = overflowPolicy;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    list_push(&l, (void *) &data[0]);
+
+    count = list_push_n(&l, (void *) &data[1], 4);
+    TEST_ASSERT_EQUAL_UINT32(overflowPolicy == LIST_OVERFLOW_BLOCK ? 3 : 4, 
+                             count);
+    TEST_ASSERT_EQUAL_UINT32(4, list_size(&l));
+
+    count = list_pop_front_n(&l, (void *) retval, 4);
+    TEST_ASSERT_EQUAL_UINT32(4, count);
+    TEST_ASSERT_EQUAL_UINT32(overflowPolicy == LIST_OVERFLOW_BLOCK ? 10 : 20, 
+                             retval[0]);
+    TEST_ASSERT_EQUAL_UINT32(overflowPolicy == LIST_OVERFLOW_BLOCK ? 40 : 50, 
+                             retval[3]);
+}
+
+void
+test_LinkedList_should_PushPartialBatchWhenFull(void)
+{
+    batch_push_when_full(0, LIST_OVERFLOW_BLOCK);
+}
+
+void
+test_LinkedList_should_PushPartialBatchWhenFullAndMPSC(void)
+{
+    batch_push_when_full(LIST_MPSC, LIST_OVERFLOW_BLOCK);
+}
+
+void
+test_LinkedList_should_PushPartialBatchWhenFullAndTwoLock(void)
+{
+    batch_push_when_full(LIST_TWO_LOCK, LIST_OVERFLOW_BLOCK);
+}
+
+void
+test_LinkedList_should_DropOldestForBatchWhenFull(void)
+{
+    batch_push_when_full(0, LIST_OVERFLOW_DROP_OLDEST);
+}
+
+void
+test_LinkedList_should_DropOldestForBatchWhenFullAndTwoLock(void)
+{
+    batch_push_when_full(LIST_TWO_LOCK, LIST_OVERFLOW_DROP_OLDEST);
+}
+
+static void*
+batch_producer(void* arg)
+{
+    uint32_t data[100];
+    uint32_t id = (uint32_t) (uintptr_t) arg;
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0; i < NUM_ITEMS; i += 100)
+      {
+          for (j = 0; j < 100; j++)
+            {
+                data[j] = (id << 24) | (i + j);
+            }
+          list_push_n(&l, (void *) data, 100);
+      }
+
+    return NULL;
+}
+
+static void
+run_batch_producers_and_consumer(uint32_t flags)
+{
+    pthread_t threads[NUM_PRODUCERS];
+    uint32_t next[NUM_PRODUCERS] = {0};
+    uint32_t retval[64];
+    uint32_t received = 0;
+    uintptr_t i;
+    size_t j;
+    size_t count;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    for (i = 0; i < NUM_PRODUCERS; i++)
+      {
+          pthread_create(&threads[i], NULL, batch_producer, (void *) i);
+      }
+
+    while (received < NUM_PRODUCERS * NUM_ITEMS)
+      {
+          count = list_pop_front_n(&l, (void *) retval, 64);
+          for (j = 0; j < count; j++)
+            {
+                TEST_ASSERT_EQUAL_UINT32(next[retval[j] >> 24], 
+                                         retval[j] & 0xFFFFFF);
+                next[retval[j] >> 24]++;
+            }
+          received += count;
+      }
+
+    for (i = 0; i < NUM_PRODUCERS; i++)
+      {
+          pthread_join(threads[i], NULL);
+      }
+
+    TEST_ASSERT_EQUAL_UINT32(0, list_size(&l));
+}
+
+void
+test_LinkedList_should_KeepBatchOrder(void)
+{
+    run_batch_producers_and_consumer(0);
+}
+
+void
+test_LinkedList_should_KeepBatchOrderWhenMPSC(void)
+{
+    run_batch_producers_and_consumer(LIST_MPSC);
+}
+
+void
+test_LinkedList_should_KeepBatchOrderWhenTwoLock(void)
+{
+    run_batch_producers_and_consumer(LIST_TWO_LOCK);
+}
+
+static void
+splice_lists(uint32_t dstFlags, uint32_t srcFlags)
+{
+    const int16_t data[] = {10, 20, 30, 40, 50, 60};
+    list_t src;
+    int16_t retval;
+    int16_t i;
+    uint8_t error;
+    list_config_t config = {0};
+
+    config.flags = dstFlags;
+    list_init_config(&l, sizeof(int16_t), &config);
+    config.flags = srcFlags;
+    list_init_config(&src, sizeof(int16_t), &config);
+
+    list_push(&l, (void *) &data[0]);
+    list_push(&l, (void *) &data[1]);
+    list_push(&src, (void *) &data[2]);
+    list_push(&src, (void *) &data[3]);
+    list_push(&src, (void *) &data[4]);
+
+    error = list_splice(&l, &src);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+    TEST_ASSERT_EQUAL_UINT32(5, list_size(&l));
+    TEST_ASSERT_EQUAL_UINT32(0, list_size(&src));
+
+    // Splicing an empty list leaves the destination as it is
+    error = list_splice(&l, &src);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+    TEST_ASSERT_EQUAL_UINT32(5, list_size(&l));
+
+    // Both lists keep working after the splice
+    list_push(&l, (void *) &data[5]);
+    list_push(&src, (void *) &data[0]);
+    error = list_pop_front(&src, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(10, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    for (i = 5; i >= 2; i--)
+      {
+          error = list_pop(&l, (void *) &retval);
+          TEST_ASSERT_EQUAL_INT16(data[i], retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+
+    for (i = 0; i < 2; i++)
+      {
+          error = list_pop_front(&l, (void *) &retval);
+          TEST_ASSERT_EQUAL_INT16(data[i], retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+
+    TEST_ASSERT_EQUAL_UINT32(0, list_size(&l));
+
+    list_destroy(&src);
+}
+
+void
+test_LinkedList_should_SpliceLists(void)
+{
+    splice_lists(0, 0);
+}
+
+void
+test_LinkedList_should_SpliceListsWhenDoublyLinked(void)
+{
+    splice_lists(LIST_DOUBLY_LINKED, LIST_DOUBLY_LINKED);
+}
+
+void
+test_LinkedList_should_SpliceListsWhenMPSC(void)
+{
+    splice_lists(0, LIST_MPSC);
+    list_destroy(&l);
+    splice_lists(LIST_MPSC, LIST_MPSC);
+}
+
+void
+test_LinkedList_should_SpliceListsWhenTwoLock(void)
+{
+    splice_lists(LIST_MPSC, LIST_TWO_LOCK);
+    list_destroy(&l);
+    splice_lists(LIST_TWO_LOCK, 0);
+}
+
+#define SPLICE_CAPACITY     64
+
+static void
+receive(list_t* list, uint32_t* next, uint32_t* received)
+{
+    uint32_t retval;
+
+    if (list_pop_front(list, (void *) &retval) == 0)
+      {
+          TEST_ASSERT_EQUAL_UINT32(next[retval >> 24], retval & 0xFFFFFF);
+          next[retval >> 24]++;
+          (*received)++;
+      }
+}
+
+static void
+splice_while_pushing(uint32_t dstFlags)
+{
+    pthread_t threads[NUM_PRODUCERS];
+    uint32_t next[NUM_PRODUCERS] = {0};
+    uint32_t received = 0;
+    list_t dst;
+    uintptr_t i;
+    size_t n;
+    list_config_t config = {0};
+
+    config.flags = LIST_MPSC;
+    list_init_config(&l, sizeof(uint32_t), &config);
+    config.flags = dstFlags;
+    config.capacity = SPLICE_CAPACITY;
+    list_init_config(&dst, sizeof(uint32_t), &config);
+
+    for (i = 0; i < NUM_PRODUCERS; i++)
+      {
+          pthread_create(&threads[i], NULL, producer, (void *) i);
+      }
+
+    while (received < NUM_PRODUCERS * NUM_ITEMS)
+      {
+          if (list_splice(&dst, &l) != 0)
+            {
+                // The source doesn't fit, take its oldest element once the 
+                // destination is empty to keep the order
+                while (list_size(&dst) > 0)
+                  {
+                      receive(&dst, next, &received);
+                  }
+                receive(&l, next, &received);
+            }
+
+          // The elements pushed during the splice must not overfill it
+          TEST_ASSERT_TRUE(list_size(&dst) <= SPLICE_CAPACITY);
+
+          for (n = list_size(&dst) / 2 + 1; n > 0; n--)
+            {
+                receive(&dst, next, &received);
+            }
+      }
+
+    for (i = 0; i < NUM_PRODUCERS; i++)
+      {
+          pthread_join(threads[i], NULL);
+      }
+
+    TEST_ASSERT_EQUAL_UINT32(0, list_size(&dst));
+    list_destroy(&dst);
+}
+
+void
+test_LinkedList_should_NotOverfillSpliceWhilePushing(void)
+{
+    splice_while_pushing(0);
+    list_destroy(&l);
+    splice_while_pushing(LIST_MPSC);
+}
+
+void
+test_LinkedList_should_RejectInvalidSplice(void)
+{
+    const int16_t data = 10;
+    list_t src;
+    list_t out;
+    uint8_t error;
+    list_config_t config = {0};
+
+    config.capacity = 1;
+    list_init_config(&l, sizeof(int16_t), &config);
+
+    list_init(&src, sizeof(int32_t));
+    error = list_splice(&l, &src);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+    list_destroy(&src);
+
+    config.capacity = 0;
+    config.flags = LIST_DOUBLY_LINKED;
+    list_init_config(&src, sizeof(int16_t), &config);
+    error = list_splice(&l, &src);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+    list_destroy(&src);
+
+    list_init_pooled(&src, sizeof(int16_t), 16);
+    error = list_splice(&l, &src);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+    error = list_take_all(&src, &out);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+    list_destroy(&src);
+
+    // The elements don't fit in the bounded list
+    list_init(&src, sizeof(int16_t));
+    list_push(&src, (void *) &data);
+    list_push(&src, (void *) &data);
+    error = list_splice(&l, &src);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+    TEST_ASSERT_EQUAL_UINT32(2, list_size(&src));
+    TEST_ASSERT_EQUAL_UINT32(0, list_size(&l));
+    list_destroy(&src);
+
+    error = list_splice(&l, &l);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+}
+
+static void
+take_all_from_producers(uint32_t flags)
+{
+    pthread_t threads[NUM_PRODUCERS];
+    uint32_t next[NUM_PRODUCERS] = {0};
+    list_t backlog;
+    uint32_t retval;
+    uint32_t received = 0;
+    uintptr_t i;
+    uint8_t error;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    for (i = 0; i < NUM_PRODUCERS; i++)
+      {
+          pthread_create(&threads[i], NULL, producer, (void *) i);
+      }
+
+    while (received < NUM_PRODUCERS * NUM_ITEMS)
+      {
+          error = list_take_all(&l, &backlog);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+
+          while (list_pop_front(&backlog, (void *) &retval) == 0)
+            {
+                TEST_ASSERT_EQUAL_UINT32(next[retval >> 24], retval & 0xFFFFFF);
+                next[retval >> 24]++;
+                received++;
+            }
+
+          list_destroy(&backlog);
+      }
+
+    for (i = 0; i < NUM_PRODUCERS; i++)
+      {
+          pthread_join(threads[i], NULL);
+      }
+
+    TEST_ASSERT_EQUAL_UINT32(0, list_size(&l));
+}
+
+void
+test_LinkedList_should_TakeAllFromProducers(void)
+{
+    take_all_from_producers(0);
+}
+
+void
+test_LinkedList_should_TakeAllFromProducersWhenMPSC(void)
+{
+    take_all_from_producers(LIST_MPSC);
+}
+
+void
+test_LinkedList_should_TakeAllFromProducersWhenTwoLock(void)
+{
+    take_all_from_producers(LIST_TWO_LOCK);
+}
+
+static void
+peek_elements(uint32_t flags)
+{
+    const int16_t data[] = {10, 20, 30};
+    int16_t* value;
+    int16_t retval;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    list_init_config(&l, sizeof(int16_t), &config);
+
+    value = list_peek_front(&l);
+    TEST_ASSERT_NULL(value);
+
+    list_push(&l, (void *) &data[0]);
+    list_push(&l, (void *) &data[1]);
+    list_push(&l, (void *) &data[2]);
+
+    value = list_peek_front(&l);
+    TEST_ASSERT_NOT_NULL(value);
+    TEST_ASSERT_EQUAL_INT16(10, *value);
+    list_peek_end(&l);
+
+    // The value can be modified in place
+    value = list_peek_at(&l, 2);
+    TEST_ASSERT_NOT_NULL(value);
+    TEST_ASSERT_EQUAL_INT16(30, *value);
+    *value = 35;
+    list_peek_end(&l);
+
+    value = list_peek_at(&l, 3);
+    TEST_ASSERT_NULL(value);
+
+    TEST_ASSERT_EQUAL_UINT32(3, list_size(&l));
+    list_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(35, retval);
+}
+
+void
+test_LinkedList_should_PeekElements(void)
+{
+    peek_elements(0);
+}
+
+void
+test_LinkedList_should_PeekElementsWhenMPSC(void)
+{
+    peek_elements(LIST_MPSC);
+}
+
+void
+test_LinkedList_should_PeekElementsWhenTwoLock(void)
+{
+    peek_elements(LIST_TWO_LOCK);
+}
+
+static void
+borrow_elements(uint32_t flags, size_t nodesPerChunk)
+{
+    const int16_t data[] = {10, 20, 30};
+    int16_t* first;
+    int16_t* second;
+    int16_t retval;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    config.nodesPerChunk = nodesPerChunk;
+    list_init_config(&l, sizeof(int16_t), &config);
+
+    TEST_ASSERT_NULL(list_pop_front_borrow(&l));
+
+    list_push(&l, (void *) &data[0]);
+    list_push(&l, (void *) &data[1]);
+    list_push(&l, (void *) &data[2]);
+
+    first = list_pop_front_borrow(&l);
+    second = list_pop_front_borrow(&l);
+    TEST_ASSERT_EQUAL_INT16(10, *first);
+    TEST_ASSERT_EQUAL_INT16(20, *second);
+    TEST_ASSERT_EQUAL_UINT32(1, list_size(&l));
+
+    // The borrowed values stay valid while the list changes
+    list_push(&l, (void *) &data[0]);
+    list_borrow_release(&l, first);
+    TEST_ASSERT_EQUAL_INT16(20, *second);
+    list_borrow_release(&l, second);
+
+    // The last node can be borrowed and the list keeps working
+    first = list_pop_front_borrow(&l);
+    second = list_pop_front_borrow(&l);
+    TEST_ASSERT_EQUAL_INT16(30, *first);
+    TEST_ASSERT_EQUAL_INT16(10, *second);
+    TEST_ASSERT_NULL(list_pop_front_borrow(&l));
+    list_borrow_release(&l, first);
+    list_borrow_release(&l, second);
+
+    list_push(&l, (void *) &data[1]);
+    list_push_front(&l, (void *) &data[2]);
+    list_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
+    list_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(30, retval);
+    TEST_ASSERT_EQUAL_UINT32(0, list_size(&l));
+}
+
+void
+test_LinkedList_should_BorrowElements(void)
+{
+    borrow_elements(0, 0);
+}
+
+void
+test_LinkedList_should_BorrowElementsWhenDoublyLinked(void)
+{
+    borrow_elements(LIST_DOUBLY_LINKED, 0);
+}
+
+void
+test_LinkedList_should_BorrowElementsWithPool(void)
+{
+    borrow_elements(0, 2);
+}
+
+void
+test_LinkedList_should_BorrowElementsWhenMPSC(void)
+{
+    borrow_elements(LIST_MPSC, 0);
+}
+
+void
+test_LinkedList_should_BorrowElementsWhenTwoLock(void)
+{
+    borrow_elements(LIST_TWO_LOCK, 0);
+}
+
+static void
+borrow_from_producers(uint32_t flags)
+{
+    pthread_t threads[NUM_PRODUCERS];
+    uint32_t next[NUM_PRODUCERS] = {0};
+    uint32_t* value;
+    uint32_t received = 0;
+    uintptr_t i;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    for (i = 0; i < NUM_PRODUCERS; i++)
+      {
+          pthread_create(&threads[i], NULL, producer, (void *) i);
+      }
+
+    while (received < NUM_PRODUCERS * NUM_ITEMS)
+      {
+          value = list_pop_front_borrow(&l);
+          if (value != NULL)
+            {
+                TEST_ASSERT_EQUAL_UINT32(next[*value >> 24], *value & 0xFFFFFF);
+                next[*value >> 24]++;
+                received++;
+                list_borrow_release(&l, value);
+            }
+      }
+
+    for (i = 0; i < NUM_PRODUCERS; i++)
+      {
+          pthread_join(threads[i], NULL);
+      }
+
+    TEST_ASSERT_EQUAL_UINT32(0, list_size(&l));
+}
+
+void
+test_LinkedList_should_BorrowFromProducersWhenMPSC(void)
+{
+    borrow_from_producers(LIST_MPSC);
+}
+
+void
+test_LinkedList_should_BorrowFromProducersWhenTwoLock(void)
+{
+    borrow_from_producers(LIST_TWO_LOCK);
+}
+
+void
+test_LinkedList_should_WorkWithRWLock(void)
+{
+    const int16_t data[] = {10, 20, 30};
+    int16_t retval = 0;
+    uint8_t error;
+    list_config_t config = {0};
+
+    config.flags = LIST_RWLOCK;
+    error = list_init_config(&l, sizeof(int16_t), &config);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    list_push(&l, (void *) &data[1]);
+    list_push(&l, (void *) &data[2]);
+    list_push_front(&l, (void *) &data[0]);
+
+    list_for_each(&l, sum, (void*) &retval);
+    TEST_ASSERT_EQUAL_INT16(60, retval);
+    TEST_ASSERT_EQUAL_UINT32(3, list_size(&l));
+
+    error = list_get_by_index(&l, 1, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = list_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(30, retval);
+    error = list_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(10, retval);
+    TEST_ASSERT_EQUAL_UINT32(1, list_size(&l));
+}
+
+static void
+wait_for_readers(const void* data, void* arg)
+{
+    uint32_t i;
+
+    atomic_fetch_add(&numReading, 1);
+
+    // Give up after one second if the other readers can't get in
+    for (i = 0; i < 1000 && atomic_load(&numReading) < NUM_READERS; i++)
+      {
+          usleep(1000);
+      }
+
+    *(uint8_t *) arg = (atomic_load(&numReading) >= NUM_READERS);
+}
+
+static void*
+reader(void* arg)
+{
+    list_for_each(&l, wait_for_readers, arg);
+
+    return NULL;
+}
+
+void
+test_LinkedList_should_ReadInParallelWithRWLock(void)
+{
+    const int16_t data = 10;
+    pthread_t threads[NUM_READERS];
+    uint8_t together[NUM_READERS] = {0};
+    uint32_t i;
+    list_config_t config = {0};
+
+    config.flags = LIST_RWLOCK;
+    list_init_config(&l, sizeof(int16_t), &config);
+    list_push(&l, (void *) &data);
+    atomic_init(&numReading, 0);
+
+    for (i = 0; i < NUM_READERS; i++)
+      {
+          pthread_create(&threads[i], NULL, reader, (void *) &together[i]);
+      }
+
+    for (i = 0; i < NUM_READERS; i++)
+      {
+          pthread_join(threads[i], NULL);
+          TEST_ASSERT_EQUAL_UINT8(1, together[i]);
+      }
+}
+
+static void
+poll_size_while_pushing(uint32_t flags)
+{
+    pthread_t threads[NUM_PRODUCERS];
+    size_t size;
+    size_t lastSize = 0;
+    uintptr_t i;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    for (i = 0; i < NUM_PRODUCERS; i++)
+      {
+          pthread_create(&threads[i], NULL, producer, (void *) i);
+      }
+
+    // The count only grows while there are no consumers
+    while (lastSize < NUM_PRODUCERS * NUM_ITEMS)
+      {
+          size = list_size(&l);
+          TEST_ASSERT_TRUE(size >= lastSize);
+          TEST_ASSERT_TRUE(size <= NUM_PRODUCERS * NUM_ITEMS);
+          lastSize = size;
+      }
+
+    for (i = 0; i < NUM_PRODUCERS; i++)
+      {
+          pthread_join(threads[i], NULL);
+      }
+}
+
+void
+test_LinkedList_should_PollSizeWhilePushing(void)
+{
+    poll_size_while_pushing(0);
+}
+
+void
+test_LinkedList_should_PollSizeWhilePushingWhenMPSC(void)
+{
+    poll_size_while_pushing(LIST_MPSC);
+}
+
+static void
+get_elements_in_order(uint32_t flags)
+{
+    uint32_t data;
+    uint32_t retval;
+    uint8_t error;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    for (data = 0; data < 1000; data++)
+      {
+          list_push(&l, (void *) &data);
+      }
+
+    for (data = 0; data < 1000; data++)
+      {
+          error = list_get_by_index(&l, data, (void *) &retval);
+          TEST_ASSERT_EQUAL_UINT32(data, retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+
+    // Going backwards walks from the head again
+    error = list_get_by_index(&l, 10, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(10, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    // Every change before the last index accessed shifts the indexes
+    list_pop_front(&l, (void *) &retval);
+    error = list_get_by_index(&l, 10, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(11, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    data = 2000;
+    list_push_front(&l, (void *) &data);
+    error = list_get_by_index(&l, 11, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(11, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = list_get_by_index(&l, 999, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(999, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    list_pop(&l, (void *) &retval);
+    error = list_get_by_index(&l, 999, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+    error = list_get_by_index(&l, 998, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(998, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    list_free(&l);
+    error = list_get_by_index(&l, 0, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+
+    list_push(&l, (void *) &data);
+    error = list_get_by_index(&l, 0, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(2000, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+}
+
+void
+test_LinkedList_should_GetElementsInOrder(void)
+{
+    get_elements_in_order(0);
+}
+
+void
+test_LinkedList_should_GetElementsInOrderWhenDoublyLinked(void)
+{
+    get_elements_in_order(LIST_DOUBLY_LINKED);
+}
+
+void
+test_LinkedList_should_GetElementsInOrderWhenMPSC(void)
+{
+    get_elements_in_order(LIST_MPSC);
+}
+
+void
+test_LinkedList_should_GetElementsInOrderWithRWLock(void)
+{
+    get_elements_in_order(LIST_RWLOCK);
+}
+
+void
+test_LinkedList_should_IterateWithCursor(void)
+{
+    const int16_t data[] = {10, 20, 30};
+    int16_t retval;
+    int16_t total = 0;
+    list_iter_t iter;
+
+    list_init(&l, sizeof(int16_t));
+
+    list_iter_begin(&l, &iter);
+    TEST_ASSERT_EQUAL_UINT8(1, list_iter_get(&iter, (void *) &retval));
+    list_iter_end(&iter);
+
+    list_push(&l, (void *) &data[0]);
+    list_push(&l, (void *) &data[1]);
+    list_push(&l, (void *) &data[2]);
+
+    list_iter_begin(&l, &iter);
+    while (list_iter_get(&iter, (void *) &retval) == 0)
+      {
+          total += retval;
+          list_iter_next(&iter);
+      }
+    TEST_ASSERT_EQUAL_UINT8(1, list_iter_next(&iter));
+    list_iter_end(&iter);
+
+    TEST_ASSERT_EQUAL_INT16(60, total);
+}
+
+static uint8_t
+is_odd(const void* data, void* arg)
+{
+    (void) arg;
+    return (*(const uint32_t *) data & 1);
+}
+
+static int
+compare_u32(const void* data, const void* key)
+{
+    return (*(const uint32_t *) data != *(const uint32_t *) key);
+}
+
+static void
+edit_in_place(uint32_t flags, size_t nodesPerChunk)
+{
+    uint32_t data;
+    uint32_t retval;
+    uint32_t expected[] = {100, 0, 2, 200, 4, 6, 8, 300};
+    uint8_t error;
+    size_t i;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    config.nodesPerChunk = nodesPerChunk;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    for (data = 0; data < 10; data++)
+      {
+          error = list_insert_at(&l, data, (void *) &data);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+
+    error = list_insert_at(&l, 11, (void *) &data);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+
+    data = 5;
+    TEST_ASSERT_EQUAL_UINT8(0, list_find(&l, compare_u32, &data, &retval));
+    TEST_ASSERT_EQUAL_UINT32(5, retval);
+
+    TEST_ASSERT_EQUAL_size_t(5, list_remove_if(&l, is_odd, NULL));
+    TEST_ASSERT_EQUAL_UINT8(1, list_find(&l, compare_u32, &data, NULL));
+    TEST_ASSERT_EQUAL_UINT32(5, list_size(&l));
+
+    data = 100;
+    list_insert_at(&l, 0, (void *) &data);
+    data = 200;
+    list_insert_at(&l, 3, (void *) &data);
+    data = 300;
+    list_insert_at(&l, 7, (void *) &data);
+    data = 400;
+    list_insert_at(&l, 5, (void *) &data);
+
+    error = list_remove_at(&l, 5, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(400, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = list_remove_at(&l, 8, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+
+    TEST_ASSERT_EQUAL_UINT32(8, list_size(&l));
+    for (i = 0; i < 8; i++)
+      {
+          error = list_get_by_index(&l, i, (void *) &retval);
+          TEST_ASSERT_EQUAL_UINT32(expected[i], retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+
+    // The ends are still linked right after removing the first and last
+    error = list_remove_at(&l, 7, NULL);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+    error = list_remove_at(&l, 0, NULL);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    data = 500;
+    list_push(&l, (void *) &data);
+    list_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(500, retval);
+    list_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(8, retval);
+    list_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(0, retval);
+
+    // Emptying the list through remove_if leaves it usable
+    TEST_ASSERT_EQUAL_size_t(0, list_remove_if(&l, is_odd, NULL));
+    while (list_remove_at(&l, 0, NULL) == 0);
+    TEST_ASSERT_EQUAL_UINT32(0, list_size(&l));
+
+    list_push(&l, (void *) &data);
+    list_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(500, retval);
+}
+
+void
+test_LinkedList_should_EditInPlace(void)
+{
+    edit_in_place(0, 0);
+}
+
+void
+test_LinkedList_should_EditInPlaceWhenDoublyLinked(void)
+{
+    edit_in_place(LIST_DOUBLY_LINKED, 0);
+}
+
+void
+test_LinkedList_should_EditInPlaceWithPool(void)
+{
+    edit_in_place(0, 4);
+}
+
+void
+test_LinkedList_should_EditInPlaceWhenMPSC(void)
+{
+    edit_in_place(LIST_MPSC, 0);
+}
+
+void
+test_LinkedList_should_EditInPlaceWhenTwoLock(void)
+{
+    edit_in_place(LIST_TWO_LOCK, 0);
+}
+
+void
+test_LinkedList_should_EditInPlaceWithRWLock(void)
+{
+    edit_in_place(LIST_RWLOCK, 0);
+}
+
+static void
+remove_while_producing(uint32_t flags)
+{
+    pthread_t threads[NUM_PRODUCERS];
+    uint32_t next[NUM_PRODUCERS] = {0};
+    uint32_t data;
+    uint32_t id;
+    size_t removed = 0;
+    uintptr_t i;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    for (i = 0; i < NUM_PRODUCERS; i++)
+      {
+          pthread_create(&threads[i], NULL, producer, (void *) i);
+      }
+
+    while (removed < NUM_PRODUCERS * NUM_ITEMS / 2)
+      {
+          removed += list_remove_if(&l, is_odd, NULL);
+      }
+
+    for (i = 0; i < NUM_PRODUCERS; i++)
+      {
+          pthread_join(threads[i], NULL);
+      }
+
+    // The even items are left in the order of each producer
+    TEST_ASSERT_EQUAL_UINT32(NUM_PRODUCERS * NUM_ITEMS / 2, list_size(&l));
+    while (list_pop_front(&l, (void *) &data) == 0)
+      {
+          id = data >> 24;
+          TEST_ASSERT_EQUAL_UINT32(next[id], data & 0xFFFFFF);
+          next[id] += 2;
+      }
+}
+
+void
+test_LinkedList_should_RemoveWhileProducingWhenMPSC(void)
+{
+    remove_while_producing(LIST_MPSC);
+}
+
+void
+test_LinkedList_should_RemoveWhileProducingWhenTwoLock(void)
+{
+    remove_while_producing(LIST_TWO_LOCK);
+}
+
+static void
+collect_u32(const void* data, void* arg)
+{
+    uint32_t** out = arg;
+
+    **out = *(const uint32_t *) data;
+    (*out)++;
+}
+
+static int
+compare_key(const void* data, const void* key)
+{
+    // Only the high half is compared, the low half records the order
+    return (int) (*(const uint32_t *) data >> 16) - 
+           (int) (*(const uint32_t *) key >> 16);
+}
+
+static void
+sort_elements(uint32_t flags, size_t nodesPerChunk)
+{
+    uint32_t data;
+    uint32_t retval;
+    uint32_t prev = 0;
+    uint32_t i;
+    uint32_t reversed[999];
+    uint32_t* out = reversed;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    config.nodesPerChunk = nodesPerChunk;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    // Sorting an empty list or a single element does nothing
+    TEST_ASSERT_EQUAL_UINT8(0, list_sort(&l, compare_key));
+    data = 7 << 16;
+    list_push(&l, (void *) &data);
+    TEST_ASSERT_EQUAL_UINT8(0, list_sort(&l, compare_key));
+    list_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(data, retval);
+
+    srand(3);
+    for (i = 0; i < 1000; i++)
+      {
+          data = ((uint32_t) (rand() % 50) << 16) | i;
+          list_push(&l, (void *) &data);
+      }
+
+    TEST_ASSERT_EQUAL_UINT8(0, list_sort(&l, compare_key));
+    TEST_ASSERT_EQUAL_UINT32(1000, list_size(&l));
+
+    // The keys are in order and equal keys keep the order of insertion
+    for (i = 0; i < 1000; i++)
+      {
+          list_get_by_index(&l, i, (void *) &retval);
+          if (i > 0)
+            {
+                TEST_ASSERT_TRUE(compare_key(&prev, &retval) < 0 ||
+                                 (compare_key(&prev, &retval) == 0 && 
+                                  (prev & 0xFFFF) < (retval & 0xFFFF)));
+            }
+          prev = retval;
+      }
+
+    // The tail is the last node after sorting
+    data = 100 << 16;
+    list_push(&l, (void *) &data);
+    list_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(data, retval);
+    list_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(prev, retval);
+
+    // The back links follow the sorted order
+    if (flags & LIST_DOUBLY_LINKED)
+      {
+          list_for_each_reverse(&l, collect_u32, (void *) &out);
+          for (i = 0; i < 999; i++)
+            {
+                list_get_by_index(&l, i, (void *) &retval);
+                TEST_ASSERT_EQUAL_UINT32(reversed[998 - i], retval);
+            }
+      }
+}
+
+void
+test_LinkedList_should_SortElements(void)
+{
+    sort_elements(0, 0);
+}
+
+void
+test_LinkedList_should_SortElementsWhenDoublyLinked(void)
+{
+    sort_elements(LIST_DOUBLY_LINKED, 0);
+}
+
+void
+test_LinkedList_should_SortElementsWithPool(void)
+{
+    sort_elements(0, 16);
+}
+
+void
+test_LinkedList_should_SortElementsWhenTwoLock(void)
+{
+    sort_elements(LIST_TWO_LOCK, 0);
+}
+
+void
+test_LinkedList_should_SortElementsWithRWLock(void)
+{
+    sort_elements(LIST_RWLOCK, 0);
+}
+
+static void
+insert_sorted(uint32_t flags)
+{
+    uint32_t data;
+    uint32_t retval;
+    uint32_t prev = 0;
+    uint32_t i;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    config.capacity = 500;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    srand(5);
+    for (i = 0; i < 500; i++)
+      {
+          data = ((uint32_t) (rand() % 50) << 16) | i;
+          TEST_ASSERT_EQUAL_UINT8(0, list_insert_sorted(&l, compare_key, 
+                                                        (void *) &data));
+      }
+    TEST_ASSERT_EQUAL_UINT8(1, list_insert_sorted(&l, compare_key, 
+                                                  (void *) &data));
+
+    for (i = 0; i < 500; i++)
+      {
+          list_pop_front(&l, (void *) &retval);
+          if (i > 0)
+            {
+                TEST_ASSERT_TRUE(compare_key(&prev, &retval) < 0 ||
+                                 (compare_key(&prev, &retval) == 0 && 
+                                  (prev & 0xFFFF) < (retval & 0xFFFF)));
+            }
+          prev = retval;
+      }
+    TEST_ASSERT_EQUAL_UINT32(0, list_size(&l));
+}
+
+void
+test_LinkedList_should_InsertSorted(void)
+{
+    insert_sorted(0);
+}
+
+void
+test_LinkedList_should_InsertSortedWhenDoublyLinked(void)
+{
+    insert_sorted(LIST_DOUBLY_LINKED);
+}
+
+void
+test_LinkedList_should_InsertSortedWhenTwoLock(void)
+{
+    insert_sorted(LIST_TWO_LOCK);
+}
+
+void
+test_LinkedList_should_NotSortWhenMPSC(void)
+{
+    uint32_t data = 1;
+    list_config_t config = {0};
+
+    config.flags = LIST_MPSC;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    TEST_ASSERT_EQUAL_UINT8(1, list_sort(&l, compare_key));
+    TEST_ASSERT_EQUAL_UINT8(1, list_insert_sorted(&l, compare_key, &data));
+}
+
+#define NUM_PARALLEL        100000
+
+typedef struct
+{
+    uint32_t first;
+    uint32_t last;
+    uint32_t count;
+    uint32_t inOrder;
+} run_t;
+
+static void
+add_atomic(const void* data, void* arg)
+{
+    atomic_fetch_add((atomic_ullong *) arg, *(const uint32_t *) data);
+}
+
+static void
+map_run(const void* data, void* acc)
+{
+    run_t* run = (run_t *) acc;
+    uint32_t value = *(const uint32_t *) data;
+
+    if (run->count == 0)
+      {
+          run->first = value;
+      }
+    else if (value != run->last + 1)
+      {
+          run->inOrder = 0;
+      }
+    run->last = value;
+    run->count++;
+}
+
+static void
+combine_runs(void* acc, const void* other)
+{
+    run_t* run = (run_t *) acc;
+    const run_t* next = (const run_t *) other;
+
+    if (next->count == 0)
+      {
+          return;
+      }
+
+    if (run->count == 0)
+      {
+          *run = *next;
+          return;
+      }
+
+    // The runs must be combined in the order of the list
+    run->inOrder = run->inOrder && next->inOrder && 
+                   next->first == run->last + 1;
+    run->last = next->last;
+    run->count += next->count;
+}
+
+static void
+process_in_parallel(uint32_t flags, size_t nodesPerChunk)
+{
+    const run_t identity = {0, 0, 0, 1};
+    run_t run;
+    atomic_ullong total = 0;
+    uint32_t i;
+    uint8_t error;
+    list_config_t config = {0};
+
+    config.flags = flags;
+    config.nodesPerChunk = nodesPerChunk;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    // An empty list reduces to the identity
+    error = list_parallel_reduce(&l, map_run, combine_runs, 
+                                 (const void *) &identity, (void *) &run, 
+                                 sizeof(run_t), 4);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+    TEST_ASSERT_EQUAL_UINT32(0, run.count);
+
+    for (i = 0; i < NUM_PARALLEL; i++)
+      {
+          list_push(&l, (void *) &i);
+      }
+
+    list_parallel_for_each(&l, add_atomic, (void *) &total, 4);
+    TEST_ASSERT_EQUAL_UINT64((uint64_t) NUM_PARALLEL * (NUM_PARALLEL - 1) / 2,
+                             total);
+
+    error = list_parallel_reduce(&l, map_run, combine_runs, 
+                                 (const void *) &identity, (void *) &run, 
+                                 sizeof(run_t), 4);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+    TEST_ASSERT_EQUAL_UINT32(NUM_PARALLEL, run.count);
+    TEST_ASSERT_EQUAL_UINT32(0, run.first);
+    TEST_ASSERT_EQUAL_UINT32(NUM_PARALLEL - 1, run.last);
+    TEST_ASSERT_EQUAL_UINT32(1, run.inOrder);
+
+    // More threads than allowed and a single thread give the same result
+    error = list_parallel_reduce(&l, map_run, combine_runs, 
+                                 (const void *) &identity, (void *) &run, 
+                                 sizeof(run_t), 1000);
+    TEST_ASSERT_EQUAL_UINT32(NUM_PARALLEL, run.count);
+    TEST_ASSERT_EQUAL_UINT32(1, run.inOrder);
+
+    error = list_parallel_reduce(&l, map_run, combine_runs, 
+                                 (const void *) &identity, (void *) &run, 
+                                 sizeof(run_t), 1);
+    TEST_ASSERT_EQUAL_UINT32(NUM_PARALLEL, run.count);
+    TEST_ASSERT_EQUAL_UINT32(1, run.inOrder);
+}
+
+void
+test_LinkedList_should_ProcessInParallel(void)
+{
+    process_in_parallel(0, 0);
+}
+
+void
+test_LinkedList_should_ProcessInParallelWhenDoublyLinked(void)
+{
+    process_in_parallel(LIST_DOUBLY_LINKED, 0);
+}
+
+void
+test_LinkedList_should_ProcessInParallelWithPool(void)
+{
+    process_in_parallel(0, 64);
+}
+
+void
+test_LinkedList_should_ProcessInParallelWhenMPSC(void)
+{
+    process_in_parallel(LIST_MPSC, 0);
+}
+
+void
+test_LinkedList_should_ProcessInParallelWhenTwoLock(void)
+{
+    process_in_parallel(LIST_TWO_LOCK, 0);
+}
+
+void
+test_LinkedList_should_ProcessInParallelWithRWLock(void)
+{
+    process_in_parallel(LIST_RWLOCK, 0);
+}
+
+void
+test_LinkedList_should_RecordDwellTime(void)
+{
+    list_config_t config = {0};
+    list_dwell_stats_t stats;
+    uint32_t retval;
+    uint32_t i;
+    uint8_t error;
+
+    config.flags = LIST_DWELL_TIME;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    error = list_get_dwell(&l, &stats);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.count);
+
+    for (i = 0; i < 100; i++)
+      {
+          list_push(&l, (void *) &i);
+      }
+
+    usleep(2000);
+
+    for (i = 0; i < 100; i++)
+      {
+          list_pop_front(&l, (void *) &retval);
+          TEST_ASSERT_EQUAL_UINT32(i, retval);
+      }
+
+    list_get_dwell(&l, &stats);
+    TEST_ASSERT_EQUAL_UINT64(100, stats.count);
+    TEST_ASSERT_TRUE(stats.p50Ns >= 2000000);
+    TEST_ASSERT_TRUE(stats.meanNs >= 2000000);
+    TEST_ASSERT_TRUE(stats.p99Ns >= stats.p50Ns);
+    TEST_ASSERT_TRUE(stats.p999Ns >= stats.p99Ns);
+    TEST_ASSERT_TRUE(stats.maxNs >= stats.p999Ns);
+
+    list_reset_dwell(&l);
+    list_get_dwell(&l, &stats);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.count);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.maxNs);
+}
+
+void
+test_LinkedList_should_NotRecordDwellTimeByDefault(void)
+{
+    list_dwell_stats_t stats;
+    uint8_t error;
+
+    list_init(&l, sizeof(uint32_t));
+
+    error = list_get_dwell(&l, &stats);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+}
+
+void
+test_LinkedList_should_RecordDwellTimeOfEveryPop(void)
+{
+    const uint32_t data[] = {1, 2, 3, 4, 5, 6};
+    list_config_t config = {0};
+    list_dwell_stats_t stats;
+    uint32_t retval[4];
+    uint32_t* borrowed;
+    list_t other;
+
+    // The creation time is stored before the link to the previous node
+    config.flags = LIST_DWELL_TIME | LIST_DOUBLY_LINKED;
+    config.nodesPerChunk = 4;
+    list_init_config(&l, sizeof(uint32_t), &config);
+
+    list_push_n(&l, (void *) data, 6);
+
+    list_pop(&l, (void *) &retval[0]);
+    TEST_ASSERT_EQUAL_UINT32(6, retval[0]);
+    list_pop_front(&l, (void *) &retval[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, retval[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, list_pop_front_n(&l, (void *) retval, 2));
+    TEST_ASSERT_EQUAL_UINT32(3, retval[1]);
+
+    borrowed = (uint32_t *) list_pop_front_borrow(&l);
+    TEST_ASSERT_EQUAL_UINT32(4, *borrowed);
+    list_borrow_release(&l, (void *) borrowed);
+
+    // A node without the creation time can't be moved to this list
+    list_init(&other, sizeof(uint32_t));
+    TEST_ASSERT_EQUAL_UINT8(1, list_splice(&other, &l));
+    list_destroy(&other);
+
+    list_get_dwell(&l, &stats);
+    TEST_ASSERT_EQUAL_UINT64(5, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(1, list_size(&l));
+}
+
+void
+test_LinkedList_should_RecordDwellTimeWhenMPSC(void)
+{
+    list_dwell_stats_t stats;
+
+    run_producers_and_consumer(LIST_MPSC | LIST_DWELL_TIME, 0);
+
+    list_get_dwell(&l, &stats);
+    TEST_ASSERT_EQUAL_UINT64(NUM_PRODUCERS * NUM_ITEMS, stats.count);
+}
+
+void
+test_LinkedList_should_RecordDwellTimeWhenTwoLock(void)
+{
+    list_dwell_stats_t stats;
+
+    run_producers_and_consumer(LIST_TWO_LOCK | LIST_DWELL_TIME, 0);
+
+    list_get_dwell(&l, &stats);
+    TEST_ASSERT_EQUAL_UINT64(NUM_PRODUCERS * NUM_ITEMS, stats.count);
+}
+
+#if LIST_STATS
+void
+test_LinkedList_should_CountPushesAndPops(void)
+{
+    const uint32_t data[] = {1, 2, 3};
+    uint32_t retval[10];
+    uint32_t i;
+    list_stats_t stats;
+    uint8_t error;
+
+    list_init(&l, sizeof(uint32_t));
+
+    for (i = 0; i < 5; i++)
+      {
+          list_push(&l, (void *) &i);
+      }
+    list_push_n(&l, (void *) data, 3);
+
+    list_pop_front(&l, (void *) &retval[0]);
+    list_pop_front(&l, (void *) &retval[0]);
+    list_pop(&l, (void *) &retval[0]);
+    TEST_ASSERT_EQUAL_UINT32(5, list_pop_front_n(&l, (void *) retval, 10));
+
+    // Both pops find the list empty
+    list_pop_front(&l, (void *) &retval[0]);
+    TEST_ASSERT_NULL(list_pop_front_borrow(&l));
+
+    error = list_get_stats(&l, &stats);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+    TEST_ASSERT_EQUAL_UINT64(8, stats.pushes);
+    TEST_ASSERT_EQUAL_UINT64(8, stats.pops);
+    TEST_ASSERT_EQUAL_UINT64(2, stats.failedPops);
+    TEST_ASSERT_EQUAL_UINT32(8, stats.highWaterMark);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.contendedAcquisitions);
+    TEST_ASSERT_TRUE(stats.lockAcquisitions >= 11);
+    TEST_ASSERT_TRUE(stats.lockHoldNs >= stats.maxLockHoldNs);
+
+    list_push(&l, (void *) &data[0]);
+    list_reset_stats(&l);
+
+    list_get_stats(&l, &stats);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.pushes);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.pops);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.failedPops);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.lockAcquisitions);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.lockHoldNs);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.highWaterMark);
+}
+
+void
+test_LinkedList_should_CountInsertionsAndRemovals(void)
+{
+    uint32_t retval;
+    uint32_t i;
+    list_stats_t stats;
+
+    list_init(&l, sizeof(uint32_t));
+
+    for (i = 0; i < 6; i++)
+      {
+          list_insert_at(&l, i, (void *) &i);
+      }
+
+    TEST_ASSERT_EQUAL_UINT8(0, list_remove_at(&l, 1, (void *) &retval));
+    TEST_ASSERT_EQUAL_UINT8(1, list_remove_at(&l, 10, (void *) &retval));
+    TEST_ASSERT_EQUAL_UINT32(2, list_remove_if(&l, is_odd, NULL));
+    list_insert_sorted(&l, compare_key, (void *) &i);
+
+    list_get_stats(&l, &stats);
+    TEST_ASSERT_EQUAL_UINT64(7, stats.pushes);
+    TEST_ASSERT_EQUAL_UINT64(3, stats.pops);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.failedPops);
+    TEST_ASSERT_EQUAL_UINT32(6, stats.highWaterMark);
+}
+
+void
+test_LinkedList_should_CountConcurrentPushesAndPops(void)
+{
+    const uint32_t modes[] = {0, LIST_MPSC, LIST_TWO_LOCK, LIST_RWLOCK};
+    list_stats_t stats;
+    size_t i;
+
+    for (i = 0; i < sizeof(modes) / sizeof(modes[0]); i++)
+      {
+          run_producers_and_consumer(modes[i], 0);
+
+          list_get_stats(&l, &stats);
+          TEST_ASSERT_EQUAL_UINT64(NUM_PRODUCERS * NUM_ITEMS, stats.pushes);
+          TEST_ASSERT_EQUAL_UINT64(NUM_PRODUCERS * NUM_ITEMS, stats.pops);
+          TEST_ASSERT_TRUE(stats.failedPops >= 1);
+          TEST_ASSERT_TRUE(stats.highWaterMark >= 1);
+          TEST_ASSERT_TRUE(stats.contendedAcquisitions <= 
+                           stats.lockAcquisitions);
+
+          list_destroy(&l);
+      }
+
+    // Destroyed again by tearDown
+    list_init(&l, sizeof(uint32_t));
+}
+#else
+void
+test_LinkedList_should_NotGetStatsWhenCompiledOut(void)
+{
+    list_stats_t stats;
+    uint8_t error;
+
+    list_init(&l, sizeof(uint32_t));
+
+    error = list_get_stats(&l, &stats);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.pushes);
 }
+#endif
 
 int
 main(void)
@@ -294,5 +2411,106 @@ main(void)
     RUN_TEST(test_LinkedList_should_BehaveAsLIFO);
     RUN_TEST(test_LinkedList_should_WorkWithStrings);
     RUN_TEST(test_LinkedList_should_IterateElements);
+    RUN_TEST(test_LinkedList_should_ReuseNodesFromPool);
+    RUN_TEST(test_LinkedList_should_GrowAndReleasePoolChunks);
+    RUN_TEST(test_LinkedList_should_PopAtBackWhenDoublyLinked);
+    RUN_TEST(test_LinkedList_should_IterateInReverseWhenDoublyLinked);
+    RUN_TEST(test_LinkedList_should_NotIterateInReverseWhenSinglyLinked);
+    RUN_TEST(test_LinkedList_should_HoldMoreThan255Elements);
+    RUN_TEST(test_LinkedList_should_HoldMoreThan65535Elements);
+    RUN_TEST(test_LinkedList_should_KeepProducerOrderWhenMPSC);
+    RUN_TEST(test_LinkedList_should_KeepProducerOrderWhenTwoLock);
+    RUN_TEST(test_LinkedList_should_PushAndPopBothEndsWhenMPSC);
+    RUN_TEST(test_LinkedList_should_PushAndPopBothEndsWhenTwoLock);
+    RUN_TEST(test_LinkedList_should_RejectInvalidConcurrentConfig);
+    RUN_TEST(test_LinkedList_should_WaitForPush);
+    RUN_TEST(test_LinkedList_should_WaitForPushWhenMPSC);
+    RUN_TEST(test_LinkedList_should_WaitForPushWhenTwoLock);
+    RUN_TEST(test_LinkedList_should_TimeoutWaitingOnEmptyList);
+    RUN_TEST(test_LinkedList_should_WakeWaitersWhenClosed);
+    RUN_TEST(test_LinkedList_should_RejectPushWhenFull);
+    RUN_TEST(test_LinkedList_should_RejectPushWhenFullAndMPSC);
+    RUN_TEST(test_LinkedList_should_DropOldestWhenFull);
+    RUN_TEST(test_LinkedList_should_DropOldestWhenFullAndTwoLock);
+    RUN_TEST(test_LinkedList_should_WaitForRoomWhenFull);
+    RUN_TEST(test_LinkedList_should_HandOffBetweenBlockedProducerAndConsumer);
+    RUN_TEST(test_LinkedList_should_KeepProducerOrderWhenBoundedMPSC);
+    RUN_TEST(test_LinkedList_should_KeepProducerOrderWhenBoundedTwoLock);
+    RUN_TEST(test_LinkedList_should_PushAndPopInBatches);
+    RUN_TEST(test_LinkedList_should_PushAndPopInBatchesWhenDoublyLinked);
+    RUN_TEST(test_LinkedList_should_PushAndPopInBatchesWithPool);
+    RUN_TEST(test_LinkedList_should_PushAndPopInBatchesWhenMPSC);
+    RUN_TEST(test_LinkedList_should_PushAndPopInBatchesWhenTwoLock);
+    RUN_TEST(test_LinkedList_should_PushPartialBatchWhenFull);
+    RUN_TEST(test_LinkedList_should_PushPartialBatchWhenFullAndMPSC);
+    RUN_TEST(test_LinkedList_should_PushPartialBatchWhenFullAndTwoLock);
+    RUN_TEST(test_LinkedList_should_DropOldestForBatchWhenFull);
+    RUN_TEST(test_LinkedList_should_DropOldestForBatchWhenFullAndTwoLock);
+    RUN_TEST(test_LinkedList_should_KeepBatchOrder);
+    RUN_TEST(test_LinkedList_should_KeepBatchOrderWhenMPSC);
+    RUN_TEST(test_LinkedList_should_KeepBatchOrderWhenTwoLock);
+    RUN_TEST(test_LinkedList_should_SpliceLists);
+    RUN_TEST(test_LinkedList_should_SpliceListsWhenDoublyLinked);
+    RUN_TEST(test_LinkedList_should_SpliceListsWhenMPSC);
+    RUN_TEST(test_LinkedList_should_SpliceListsWhenTwoLock);
+    RUN_TEST(test_LinkedList_should_RejectInvalidSplice);
+    RUN_TEST(test_LinkedList_should_NotOverfillSpliceWhilePushing);
+    RUN_TEST(test_LinkedList_should_TakeAllFromProducers);
+    RUN_TEST(test_LinkedList_should_TakeAllFromProducersWhenMPSC);
+    RUN_TEST(test_LinkedList_should_TakeAllFromProducersWhenTwoLock);
+    RUN_TEST(test_LinkedList_should_PeekElements);
+    RUN_TEST(test_LinkedList_should_PeekElementsWhenMPSC);
+    RUN_TEST(test_LinkedList_should_PeekElementsWhenTwoLock);
+    RUN_TEST(test_LinkedList_should_BorrowElements);
+    RUN_TEST(test_LinkedList_should_BorrowElementsWhenDoublyLinked);
+    RUN_TEST(test_LinkedList_should_BorrowElementsWithPool);
+    RUN_TEST(test_LinkedList_should_BorrowElementsWhenMPSC);
+    RUN_TEST(test_LinkedList_should_BorrowElementsWhenTwoLock);
+    RUN_TEST(test_LinkedList_should_BorrowFromProducersWhenMPSC);
+    RUN_TEST(test_LinkedList_should_BorrowFromProducersWhenTwoLock);
+    RUN_TEST(test_LinkedList_should_WorkWithRWLock);
+    RUN_TEST(test_LinkedList_should_ReadInParallelWithRWLock);
+    RUN_TEST(test_LinkedList_should_PollSizeWhilePushing);
+    RUN_TEST(test_LinkedList_should_PollSizeWhilePushingWhenMPSC);
+    RUN_TEST(test_LinkedList_should_GetElementsInOrder);
+    RUN_TEST(test_LinkedList_should_GetElementsInOrderWhenDoublyLinked);
+    RUN_TEST(test_LinkedList_should_GetElementsInOrderWhenMPSC);
+    RUN_TEST(test_LinkedList_should_GetElementsInOrderWithRWLock);
+    RUN_TEST(test_LinkedList_should_IterateWithCursor);
+    RUN_TEST(test_LinkedList_should_EditInPlace);
+    RUN_TEST(test_LinkedList_should_EditInPlaceWhenDoublyLinked);
+    RUN_TEST(test_LinkedList_should_EditInPlaceWithPool);
+    RUN_TEST(test_LinkedList_should_EditInPlaceWhenMPSC);
+    RUN_TEST(test_LinkedList_should_EditInPlaceWhenTwoLock);
+    RUN_TEST(test_LinkedList_should_EditInPlaceWithRWLock);
+    RUN_TEST(test_LinkedList_should_RemoveWhileProducingWhenMPSC);
+    RUN_TEST(test_LinkedList_should_RemoveWhileProducingWhenTwoLock);
+    RUN_TEST(test_LinkedList_should_SortElements);
+    RUN_TEST(test_LinkedList_should_SortElementsWhenDoublyLinked);
+    RUN_TEST(test_LinkedList_should_SortElementsWithPool);
+    RUN_TEST(test_LinkedList_should_SortElementsWhenTwoLock);
+    RUN_TEST(test_LinkedList_should_SortElementsWithRWLock);
+    RUN_TEST(test_LinkedList_should_InsertSorted);
+    RUN_TEST(test_LinkedList_should_InsertSortedWhenDoublyLinked);
+    RUN_TEST(test_LinkedList_should_InsertSortedWhenTwoLock);
+    RUN_TEST(test_LinkedList_should_NotSortWhenMPSC);
+    RUN_TEST(test_LinkedList_should_ProcessInParallel);
+    RUN_TEST(test_LinkedList_should_ProcessInParallelWhenDoublyLinked);
+    RUN_TEST(test_LinkedList_should_ProcessInParallelWithPool);
+    RUN_TEST(test_LinkedList_should_ProcessInParallelWhenMPSC);
+    RUN_TEST(test_LinkedList_should_ProcessInParallelWhenTwoLock);
+    RUN_TEST(test_LinkedList_should_ProcessInParallelWithRWLock);
+    RUN_TEST(test_LinkedList_should_RecordDwellTime);
+    RUN_TEST(test_LinkedList_should_NotRecordDwellTimeByDefault);
+    RUN_TEST(test_LinkedList_should_RecordDwellTimeOfEveryPop);
+    RUN_TEST(test_LinkedList_should_RecordDwellTimeWhenMPSC);
+    RUN_TEST(test_LinkedList_should_RecordDwellTimeWhenTwoLock);
+#if LIST_STATS
+    RUN_TEST(test_LinkedList_should_CountPushesAndPops);
+    RUN_TEST(test_LinkedList_should_CountConcurrentPushesAndPops);
+    RUN_TEST(test_LinkedList_should_CountInsertionsAndRemovals);
+#else
+    RUN_TEST(test_LinkedList_should_NotGetStatsWhenCompiledOut);
+#endif
     return UNITY_END();
 }
\ No newline at end of file
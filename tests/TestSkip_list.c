@@ -0,0 +1,248 @@
+#include "unity.h"
+#include "Skip_list.h"
+
+#define NUM_ELEMENTS        1000
+#define NUM_OPERATIONS      5000
+
+static skiplist_t l;
+
+void
+setUp(void)
+{
+
+}
+
+void
+tearDown(void)
+{
+    skiplist_destroy(&l);
+}
+
+void sum(const void* data, void* arg)
+{
+    *(int32_t *) arg += *(int16_t *) data;
+}
+
+void
+test_SkipList_should_PushAtBack(void)
+{
+    const int16_t data[] = {10, 20, 30};
+    int16_t retval;
+    uint8_t error;
+
+    skiplist_init(&l, sizeof(int16_t));
+
+    skiplist_push(&l, (void *) &data[0]);
+    skiplist_push(&l, (void *) &data[1]);
+    skiplist_push(&l, (void *) &data[2]);
+
+    error = skiplist_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(30, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = skiplist_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = skiplist_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(10, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = skiplist_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+}
+
+void
+test_SkipList_should_PushAtFront(void)
+{
+    const int16_t data[] = {30, 20, 10};
+    int16_t retval;
+    uint8_t error;
+
+    skiplist_init(&l, sizeof(int16_t));
+
+    skiplist_push_front(&l, (void *) &data[0]);
+    skiplist_push_front(&l, (void *) &data[1]);
+    skiplist_push_front(&l, (void *) &data[2]);
+
+    error = skiplist_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(10, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = skiplist_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = skiplist_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(30, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = skiplist_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+}
+
+void
+test_SkipList_should_GetElements(void)
+{
+    int16_t data;
+    int16_t retval;
+    uint8_t error;
+
+    skiplist_init(&l, sizeof(int16_t));
+
+    for (data = 0; data < NUM_ELEMENTS; data++)
+      {
+          skiplist_push(&l, (void *) &data);
+      }
+    TEST_ASSERT_EQUAL_UINT32(NUM_ELEMENTS, skiplist_size(&l));
+
+    for (data = 0; data < NUM_ELEMENTS; data++)
+      {
+          error = skiplist_get_by_index(&l, data, (void *) &retval);
+          TEST_ASSERT_EQUAL_INT16(data, retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+
+    error = skiplist_get_by_index(&l, NUM_ELEMENTS, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+}
+
+void
+test_SkipList_should_InsertAndRemoveAtIndex(void)
+{
+    const int16_t data[] = {10, 20, 30, 40};
+    int16_t retval;
+    uint8_t error;
+
+    skiplist_init(&l, sizeof(int16_t));
+
+    skiplist_push(&l, (void *) &data[0]);
+    skiplist_push(&l, (void *) &data[3]);
+
+    error = skiplist_insert_at(&l, 1, (void *) &data[2]);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+    error = skiplist_insert_at(&l, 1, (void *) &data[1]);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+    error = skiplist_insert_at(&l, 5, (void *) &data[1]);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+
+    skiplist_get_by_index(&l, 1, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
+    skiplist_get_by_index(&l, 2, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(30, retval);
+
+    error = skiplist_remove_at(&l, 2, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(30, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = skiplist_remove_at(&l, 3, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+
+    skiplist_get_by_index(&l, 2, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(40, retval);
+    TEST_ASSERT_EQUAL_UINT32(3, skiplist_size(&l));
+}
+
+void
+test_SkipList_should_MatchArrayAfterRandomOperations(void)
+{
+    int32_t model[NUM_OPERATIONS];
+    size_t numModel = 0;
+    int32_t data;
+    int32_t retval;
+    size_t index;
+    size_t i;
+    uint8_t error;
+
+    skiplist_init(&l, sizeof(int32_t));
+    srand(7);
+
+    for (data = 0; data < NUM_OPERATIONS; data++)
+      {
+          // Insert two elements for every one removed so the list grows
+          if (numModel > 0 && rand() % 3 == 0)
+            {
+                index = (size_t) rand() % numModel;
+                error = skiplist_remove_at(&l, index, (void *) &retval);
+                TEST_ASSERT_EQUAL_UINT8(0, error);
+                TEST_ASSERT_EQUAL_INT32(model[index], retval);
+
+                memmove(&model[index], &model[index + 1],
+                        (numModel - index - 1) * sizeof(int32_t));
+                numModel--;
+            }
+          else
+            {
+                index = (size_t) rand() % (numModel + 1);
+                error = skiplist_insert_at(&l, index, (void *) &data);
+                TEST_ASSERT_EQUAL_UINT8(0, error);
+
+                memmove(&model[index + 1], &model[index],
+                        (numModel - index) * sizeof(int32_t));
+                model[index] = data;
+                numModel++;
+            }
+      }
+
+    TEST_ASSERT_EQUAL_UINT32(numModel, skiplist_size(&l));
+    for (i = 0; i < numModel; i++)
+      {
+          error = skiplist_get_by_index(&l, i, (void *) &retval);
+          TEST_ASSERT_EQUAL_INT32(model[i], retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+}
+
+void
+test_SkipList_should_IterateElements(void)
+{
+    int16_t data;
+    int32_t total = 0;
+
+    skiplist_init(&l, sizeof(int16_t));
+
+    for (data = 0; data < NUM_ELEMENTS; data++)
+      {
+          skiplist_push_front(&l, (void *) &data);
+      }
+
+    skiplist_for_each(&l, sum, (void *) &total);
+    TEST_ASSERT_EQUAL_INT32(NUM_ELEMENTS * (NUM_ELEMENTS - 1) / 2, total);
+}
+
+void
+test_SkipList_should_BeUsableAfterFree(void)
+{
+    const int16_t data[] = {10, 20};
+    int16_t retval;
+    uint8_t error;
+
+    skiplist_init(&l, sizeof(int16_t));
+
+    skiplist_push(&l, (void *) &data[0]);
+    skiplist_push(&l, (void *) &data[1]);
+    skiplist_free(&l);
+    TEST_ASSERT_EQUAL_UINT32(0, skiplist_size(&l));
+
+    error = skiplist_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+
+    skiplist_push(&l, (void *) &data[1]);
+    error = skiplist_get_by_index(&l, 0, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+}
+
+int
+main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_SkipList_should_PushAtBack);
+    RUN_TEST(test_SkipList_should_PushAtFront);
+    RUN_TEST(test_SkipList_should_GetElements);
+    RUN_TEST(test_SkipList_should_InsertAndRemoveAtIndex);
+    RUN_TEST(test_SkipList_should_MatchArrayAfterRandomOperations);
+    RUN_TEST(test_SkipList_should_IterateElements);
+    RUN_TEST(test_SkipList_should_BeUsableAfterFree);
+    return UNITY_END();
+}
@@ -0,0 +1,284 @@
+#include "unity.h"
+#include "Unrolled_list.h"
+
+#define NUM_ELEMENTS        1000
+
+static ulist_t l;
+
+void
+setUp(void)
+{
+
+}
+
+void
+tearDown(void)
+{
+    ulist_destroy(&l);
+}
+
+void sum(const void* data, void* arg)
+{
+    *(int32_t *) arg += *(int16_t *) data;
+}
+
+void
+test_UnrolledList_should_PushAtBack(void)
+{
+    const int16_t data[] = {10, 20, 30};
+    int16_t retval;
+    uint8_t error;
+
+    ulist_init(&l, sizeof(int16_t));
+
+    ulist_push(&l, (void *) &data[0]);
+    ulist_push(&l, (void *) &data[1]);
+    ulist_push(&l, (void *) &data[2]);
+
+    error = ulist_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(30, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = ulist_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = ulist_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(10, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = ulist_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+}
+
+void
+test_UnrolledList_should_PushAtFront(void)
+{
+    const int16_t data[] = {30, 20, 10};
+    int16_t retval;
+    uint8_t error;
+
+    ulist_init(&l, sizeof(int16_t));
+
+    ulist_push_front(&l, (void *) &data[0]);
+    ulist_push_front(&l, (void *) &data[1]);
+    ulist_push_front(&l, (void *) &data[2]);
+
+    error = ulist_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(10, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = ulist_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = ulist_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(30, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = ulist_pop_front(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+}
+
+void
+test_UnrolledList_should_BehaveAsFIFOAcrossBlocks(void)
+{
+    int16_t data;
+    int16_t retval;
+    uint8_t error;
+
+    ulist_init_sized(&l, sizeof(int16_t), 64);
+
+    for (data = 0; data < NUM_ELEMENTS; data++)
+      {
+          ulist_push(&l, (void *) &data);
+      }
+    TEST_ASSERT_EQUAL_UINT32(NUM_ELEMENTS, ulist_size(&l));
+
+    for (data = 0; data < NUM_ELEMENTS; data++)
+      {
+          error = ulist_pop_front(&l, (void *) &retval);
+          TEST_ASSERT_EQUAL_INT16(data, retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+
+    TEST_ASSERT_EQUAL_UINT32(0, ulist_size(&l));
+}
+
+void
+test_UnrolledList_should_BehaveAsLIFOAcrossBlocks(void)
+{
+    int16_t data;
+    int16_t retval;
+    uint8_t error;
+
+    ulist_init_sized(&l, sizeof(int16_t), 64);
+
+    for (data = 0; data < NUM_ELEMENTS; data++)
+      {
+          ulist_push_front(&l, (void *) &data);
+      }
+
+    for (data = 0; data < NUM_ELEMENTS; data++)
+      {
+          error = ulist_pop_front(&l, (void *) &retval);
+          TEST_ASSERT_EQUAL_INT16(NUM_ELEMENTS - 1 - data, retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+}
+
+void
+test_UnrolledList_should_MixBothEnds(void)
+{
+    int16_t data;
+    int16_t retval;
+    uint8_t error;
+
+    ulist_init_sized(&l, sizeof(int16_t), 64);
+
+    // Front elements are negative, back elements are positive
+    for (data = 1; data <= 100; data++)
+      {
+          ulist_push(&l, (void *) &data);
+          retval = -data;
+          ulist_push_front(&l, (void *) &retval);
+      }
+
+    for (data = 100; data >= 1; data--)
+      {
+          error = ulist_pop_front(&l, (void *) &retval);
+          TEST_ASSERT_EQUAL_INT16(-data, retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+
+          error = ulist_pop(&l, (void *) &retval);
+          TEST_ASSERT_EQUAL_INT16(data, retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+
+    TEST_ASSERT_EQUAL_UINT32(0, ulist_size(&l));
+}
+
+void
+test_UnrolledList_should_GetElements(void)
+{
+    int16_t data;
+    int16_t retval;
+    uint8_t error;
+
+    ulist_init_sized(&l, sizeof(int16_t), 64);
+
+    for (data = 0; data < NUM_ELEMENTS; data++)
+      {
+          ulist_push(&l, (void *) &data);
+      }
+
+    // The first block is no longer full after a pop
+    ulist_pop_front(&l, (void *) &retval);
+
+    for (data = 1; data < NUM_ELEMENTS; data++)
+      {
+          error = ulist_get_by_index(&l, data - 1, (void *) &retval);
+          TEST_ASSERT_EQUAL_INT16(data, retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+
+    error = ulist_get_by_index(&l, NUM_ELEMENTS - 1, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+}
+
+void
+test_UnrolledList_should_IterateElements(void)
+{
+    int16_t data;
+    int32_t total = 0;
+
+    ulist_init_sized(&l, sizeof(int16_t), 64);
+
+    for (data = 0; data < NUM_ELEMENTS; data++)
+      {
+          ulist_push(&l, (void *) &data);
+      }
+
+    ulist_for_each(&l, sum, (void *) &total);
+    TEST_ASSERT_EQUAL_INT32(NUM_ELEMENTS * (NUM_ELEMENTS - 1) / 2, total);
+}
+
+void
+test_UnrolledList_should_AllocateBlocksOnlyWhenFull(void)
+{
+    int16_t data;
+    int16_t retval;
+    ulist_info_t info;
+
+    ulist_init(&l, sizeof(int16_t));
+
+    ulist_info(&l, &info);
+    TEST_ASSERT_EQUAL_UINT32(0, info.numBlocks);
+    TEST_ASSERT_EQUAL_UINT32((ULIST_DEFAULT_BLOCK_SIZE -
+                              sizeof(ulist_block_t)) / sizeof(int16_t),
+                             info.elementsPerBlock);
+
+    for (data = 0; data < (int16_t) info.elementsPerBlock; data++)
+      {
+          ulist_push(&l, (void *) &data);
+      }
+
+    ulist_info(&l, &info);
+    TEST_ASSERT_EQUAL_UINT32(1, info.numBlocks);
+    TEST_ASSERT_EQUAL_UINT32(ULIST_DEFAULT_BLOCK_SIZE, info.numBytes);
+
+    ulist_push(&l, (void *) &data);
+    ulist_info(&l, &info);
+    TEST_ASSERT_EQUAL_UINT32(2, info.numBlocks);
+
+    // The emptied block is kept as a spare and reused by the next push
+    for (data = 0; data < (int16_t) info.elementsPerBlock; data++)
+      {
+          ulist_pop_front(&l, (void *) &retval);
+      }
+
+    ulist_info(&l, &info);
+    TEST_ASSERT_EQUAL_UINT32(1, info.numBlocks);
+    TEST_ASSERT_EQUAL_UINT32(2 * ULIST_DEFAULT_BLOCK_SIZE, info.numBytes);
+
+    ulist_push_front(&l, (void *) &data);
+    ulist_info(&l, &info);
+    TEST_ASSERT_EQUAL_UINT32(2, info.numBlocks);
+    TEST_ASSERT_EQUAL_UINT32(2 * ULIST_DEFAULT_BLOCK_SIZE, info.numBytes);
+}
+
+void
+test_UnrolledList_should_HoldAtLeastOneElementPerBlock(void)
+{
+    const int64_t data[] = {10, 20};
+    int64_t retval;
+    ulist_info_t info;
+
+    ulist_init_sized(&l, sizeof(int64_t), 1);
+
+    ulist_push(&l, (void *) &data[0]);
+    ulist_push(&l, (void *) &data[1]);
+
+    ulist_info(&l, &info);
+    TEST_ASSERT_EQUAL_UINT32(1, info.elementsPerBlock);
+    TEST_ASSERT_EQUAL_UINT32(2, info.numBlocks);
+
+    ulist_pop(&l, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT64(20, retval);
+}
+
+int
+main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_UnrolledList_should_PushAtBack);
+    RUN_TEST(test_UnrolledList_should_PushAtFront);
+    RUN_TEST(test_UnrolledList_should_BehaveAsFIFOAcrossBlocks);
+    RUN_TEST(test_UnrolledList_should_BehaveAsLIFOAcrossBlocks);
+    RUN_TEST(test_UnrolledList_should_MixBothEnds);
+    RUN_TEST(test_UnrolledList_should_GetElements);
+    RUN_TEST(test_UnrolledList_should_IterateElements);
+    RUN_TEST(test_UnrolledList_should_AllocateBlocksOnlyWhenFull);
+    RUN_TEST(test_UnrolledList_should_HoldAtLeastOneElementPerBlock);
+    return UNITY_END();
+}
@@ -0,0 +1,315 @@
+#include <pthread.h>
+#include "unity.h"
+#include "Ws_deque.h"
+
+#define NUM_ELEMENTS        1000
+#define NUM_THIEVES         3
+#define NUM_STEAL_ITEMS     100000
+#define NUM_RACES           100000
+#define POP_SENTINEL        0xFFFFFFFFu
+
+typedef struct
+{
+    uint32_t id;
+    char name[9];
+} record_t;
+
+static wsdeque_t dq;
+static atomic_uint seen[NUM_STEAL_ITEMS];
+static atomic_int done;
+static atomic_uint numStolen;
+
+void
+setUp(void)
+{
+
+}
+
+void
+tearDown(void)
+{
+    wsdeque_destroy(&dq);
+}
+
+void
+test_WsDeque_should_PopAsLIFO(void)
+{
+    const int16_t data[] = {10, 20, 30};
+    int16_t retval;
+    uint8_t error;
+
+    wsdeque_init(&dq, sizeof(int16_t));
+
+    wsdeque_push(&dq, (void *) &data[0]);
+    wsdeque_push(&dq, (void *) &data[1]);
+    wsdeque_push(&dq, (void *) &data[2]);
+    TEST_ASSERT_EQUAL_UINT32(3, wsdeque_size(&dq));
+
+    error = wsdeque_pop(&dq, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(30, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = wsdeque_pop(&dq, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = wsdeque_pop(&dq, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(10, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = wsdeque_pop(&dq, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+    TEST_ASSERT_EQUAL_UINT32(0, wsdeque_size(&dq));
+}
+
+void
+test_WsDeque_should_StealAsFIFO(void)
+{
+    const int16_t data[] = {10, 20, 30};
+    int16_t retval;
+    uint8_t error;
+
+    wsdeque_init(&dq, sizeof(int16_t));
+
+    wsdeque_push(&dq, (void *) &data[0]);
+    wsdeque_push(&dq, (void *) &data[1]);
+    wsdeque_push(&dq, (void *) &data[2]);
+
+    error = wsdeque_steal(&dq, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(10, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = wsdeque_steal(&dq, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(20, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    // The owner and the thieves share the last element
+    error = wsdeque_pop(&dq, (void *) &retval);
+    TEST_ASSERT_EQUAL_INT16(30, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+
+    error = wsdeque_steal(&dq, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+}
+
+void
+test_WsDeque_should_GrowWhenFull(void)
+{
+    uint32_t data;
+    uint32_t retval;
+    uint8_t error;
+
+    wsdeque_init_capacity(&dq, sizeof(uint32_t), 4);
+
+    for (data = 0; data < NUM_ELEMENTS; data++)
+      {
+          wsdeque_push(&dq, (void *) &data);
+      }
+    TEST_ASSERT_EQUAL_UINT32(NUM_ELEMENTS, wsdeque_size(&dq));
+
+    // Half from each end
+    for (data = 0; data < NUM_ELEMENTS / 2; data++)
+      {
+          error = wsdeque_steal(&dq, (void *) &retval);
+          TEST_ASSERT_EQUAL_UINT32(data, retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+
+          error = wsdeque_pop(&dq, (void *) &retval);
+          TEST_ASSERT_EQUAL_UINT32(NUM_ELEMENTS - 1 - data, retval);
+          TEST_ASSERT_EQUAL_UINT8(0, error);
+      }
+
+    TEST_ASSERT_EQUAL_UINT32(0, wsdeque_size(&dq));
+}
+
+void
+test_WsDeque_should_WrapAroundTheBuffer(void)
+{
+    uint32_t data;
+    uint32_t retval;
+    uint8_t error;
+
+    wsdeque_init_capacity(&dq, sizeof(uint32_t), 8);
+
+    // Never more than two elements, so the buffer is reused without growing
+    for (data = 0; data < NUM_ELEMENTS; data++)
+      {
+          wsdeque_push(&dq, (void *) &data);
+          if (data > 0)
+            {
+                error = wsdeque_steal(&dq, (void *) &retval);
+                TEST_ASSERT_EQUAL_UINT32(data - 1, retval);
+                TEST_ASSERT_EQUAL_UINT8(0, error);
+            }
+      }
+
+    error = wsdeque_pop(&dq, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(NUM_ELEMENTS - 1, retval);
+    TEST_ASSERT_EQUAL_UINT8(0, error);
+}
+
+void
+test_WsDeque_should_CopyElementsOfAnySize(void)
+{
+    record_t data;
+    record_t retval;
+    uint32_t i;
+
+    wsdeque_init_capacity(&dq, sizeof(record_t), 2);
+
+    for (i = 0; i < 10; i++)
+      {
+          data.id = i;
+          snprintf(data.name, sizeof(data.name), "record%u", i);
+          wsdeque_push(&dq, (void *) &data);
+      }
+
+    wsdeque_steal(&dq, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(0, retval.id);
+    TEST_ASSERT_EQUAL_STRING("record0", retval.name);
+
+    wsdeque_pop(&dq, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT32(9, retval.id);
+    TEST_ASSERT_EQUAL_STRING("record9", retval.name);
+}
+
+void *
+thief(void* arg)
+{
+    uint32_t retval;
+
+    (void) arg;
+
+    while (!atomic_load(&done) || wsdeque_size(&dq) > 0)
+      {
+          if (wsdeque_steal(&dq, (void *) &retval) == 0)
+            {
+                atomic_fetch_add(&seen[retval], 1);
+            }
+      }
+
+    return NULL;
+}
+
+void
+test_WsDeque_should_HandOutEveryElementOnceWhenStolen(void)
+{
+    pthread_t threads[NUM_THIEVES];
+    uint32_t retval;
+    uint32_t data;
+    int i;
+
+    wsdeque_init_capacity(&dq, sizeof(uint32_t), 4);
+    atomic_store(&done, 0);
+    for (data = 0; data < NUM_STEAL_ITEMS; data++)
+      {
+          atomic_store(&seen[data], 0);
+      }
+
+    for (i = 0; i < NUM_THIEVES; i++)
+      {
+          pthread_create(&threads[i], NULL, thief, NULL);
+      }
+
+    // The owner pops one of every three elements it pushes
+    for (data = 0; data < NUM_STEAL_ITEMS; data++)
+      {
+          wsdeque_push(&dq, (void *) &data);
+          if (data % 3 == 0 && wsdeque_pop(&dq, (void *) &retval) == 0)
+            {
+                atomic_fetch_add(&seen[retval], 1);
+            }
+      }
+
+    while (wsdeque_pop(&dq, (void *) &retval) == 0)
+      {
+          atomic_fetch_add(&seen[retval], 1);
+      }
+    atomic_store(&done, 1);
+
+    for (i = 0; i < NUM_THIEVES; i++)
+      {
+          pthread_join(threads[i], NULL);
+      }
+
+    for (data = 0; data < NUM_STEAL_ITEMS; data++)
+      {
+          TEST_ASSERT_EQUAL_UINT32(1, atomic_load(&seen[data]));
+      }
+}
+
+static void *
+racing_thief(void* arg)
+{
+    uint32_t retval;
+
+    (void) arg;
+
+    while (!atomic_load(&done))
+      {
+          if (wsdeque_steal(&dq, (void *) &retval) == 0)
+            {
+                atomic_fetch_add(&numStolen, 1);
+            }
+      }
+
+    return NULL;
+}
+
+void
+test_WsDeque_should_NotWriteDataWhenPopFails(void)
+{
+    pthread_t thread;
+    uint32_t retval = POP_SENTINEL;
+    uint32_t numPopped = 0;
+    uint32_t data;
+    uint8_t error;
+
+    wsdeque_init(&dq, sizeof(uint32_t));
+
+    error = wsdeque_pop(&dq, (void *) &retval);
+    TEST_ASSERT_EQUAL_UINT8(1, error);
+    TEST_ASSERT_EQUAL_UINT32(POP_SENTINEL, retval);
+
+    atomic_store(&done, 0);
+    atomic_store(&numStolen, 0);
+    pthread_create(&thread, NULL, racing_thief, NULL);
+
+    // The deque never holds more than one element, so the owner and the 
+    // thief race for the last element every time
+    for (data = 0; data < NUM_RACES; data++)
+      {
+          wsdeque_push(&dq, (void *) &data);
+
+          retval = POP_SENTINEL;
+          error = wsdeque_pop(&dq, (void *) &retval);
+          if (error == 0)
+            {
+                TEST_ASSERT_EQUAL_UINT32(data, retval);
+                numPopped++;
+            }
+          else
+            {
+                TEST_ASSERT_EQUAL_UINT32(POP_SENTINEL, retval);
+            }
+      }
+
+    atomic_store(&done, 1);
+    pthread_join(thread, NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(NUM_RACES, numPopped + atomic_load(&numStolen));
+}
+
+int
+main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_WsDeque_should_PopAsLIFO);
+    RUN_TEST(test_WsDeque_should_StealAsFIFO);
+    RUN_TEST(test_WsDeque_should_GrowWhenFull);
+    RUN_TEST(test_WsDeque_should_WrapAroundTheBuffer);
+    RUN_TEST(test_WsDeque_should_CopyElementsOfAnySize);
+    RUN_TEST(test_WsDeque_should_HandOutEveryElementOnceWhenStolen);
+    RUN_TEST(test_WsDeque_should_NotWriteDataWhenPopFails);
+    return UNITY_END();
+}